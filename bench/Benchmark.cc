@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include "Benchmark.h"
+#include "usertypes/Timer.h"
+
+namespace term_engine::bench {
+  void RegisterBenchmark(const std::string& name, bool requires_engine, const BenchmarkSetup& setup, const BenchmarkTeardown& teardown)
+  {
+    benchmark_list.push_back({ name, requires_engine, setup, teardown });
+  }
+
+  BenchmarkResult RunBenchmark(const Benchmark& benchmark)
+  {
+    const BenchmarkFunction function = benchmark.setup_();
+
+    const auto run_sample = [&function](uint64_t iterations) -> uint64_t {
+      const usertypes::TimePoint start = usertypes::Clock::now();
+      function(iterations);
+
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(usertypes::Clock::now() - start).count();
+    };
+
+    uint64_t iterations = 1;
+
+    // This also warms up any caches that the operation uses, e.g. the glyphs of a font.
+    while (iterations < BENCHMARK_MAX_ITERATIONS && run_sample(iterations) < BENCHMARK_MIN_SAMPLE_TIME)
+    {
+      iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    samples.reserve(BENCHMARK_SAMPLES);
+
+    for (uint32_t sample = 0; sample < BENCHMARK_SAMPLES; ++sample)
+    {
+      samples.push_back((double)run_sample(iterations) / (double)iterations);
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    if (benchmark.teardown_)
+    {
+      benchmark.teardown_();
+    }
+
+    return { benchmark.name_, false, iterations, samples[samples.size() / 2], samples.front(), samples.back() };
+  }
+
+  void WriteResults(std::ostream& stream, BenchmarkResultList results)
+  {
+    std::sort(results.begin(), results.end(), [](const BenchmarkResult& lhs, const BenchmarkResult& rhs) { return lhs.name_ < rhs.name_; });
+
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\n";
+    stream << "  \"version\": " << BENCHMARK_OUTPUT_VERSION << ",\n";
+    stream << "  \"unit\": \"ns\",\n";
+    stream << "  \"benchmarks\": [";
+
+    for (size_t index = 0; index < results.size(); ++index)
+    {
+      const BenchmarkResult& result = results[index];
+
+      stream << (index == 0 ? "\n" : ",\n");
+      stream << "    { \"name\": \"" << result.name_ << "\", \"skipped\": " << (result.skipped_ ? "true" : "false");
+
+      if (!result.skipped_)
+      {
+        stream << ", \"iterations\": " << result.iterations_ << ", \"median\": " << result.median_ << ", \"min\": " << result.min_ << ", \"max\": " << result.max_;
+      }
+
+      stream << " }";
+    }
+
+    stream << "\n  ]\n}\n";
+  }
+}
@@ -0,0 +1,119 @@
+/// @author James Holtom
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace term_engine::bench {
+  struct Benchmark;
+  struct BenchmarkResult;
+
+  /// @brief The version of the JSON output. This is increased whenever the layout of the output changes, so that regression tracking tools can tell results apart.
+  constexpr uint32_t BENCHMARK_OUTPUT_VERSION = 1;
+  /// @brief The number of samples taken of each benchmark.
+  constexpr uint32_t BENCHMARK_SAMPLES = 15;
+  /// @brief The shortest time that each sample should take, in nanoseconds (ns). The number of iterations in a sample is increased until it takes at least this long.
+  constexpr uint64_t BENCHMARK_MIN_SAMPLE_TIME = 10000000;
+  /// @brief The most iterations that a sample can run.
+  constexpr uint64_t BENCHMARK_MAX_ITERATIONS = 1ULL << 30;
+
+  /// @brief A function that runs the operation being benchmarked the given number of times. This is the only part of a benchmark that is timed.
+  typedef std::function<void(uint64_t)> BenchmarkFunction;
+  /// @brief A function that builds what a benchmark operates on (e.g. a game scene full of objects), and returns the function that runs the operation on it.
+  typedef std::function<BenchmarkFunction()> BenchmarkSetup;
+  /// @brief A function that cleans up anything that a benchmark's setup added to the engine.
+  typedef std::function<void()> BenchmarkTeardown;
+  /// @brief Used to store the registered benchmarks.
+  typedef std::vector<Benchmark> BenchmarkList;
+  /// @brief Used to store the results of the benchmarks that were run.
+  typedef std::vector<BenchmarkResult> BenchmarkResultList;
+
+  /// @brief A benchmark of a single operation.
+  struct Benchmark {
+    /// @brief The name of the benchmark, which identifies it in the output.
+    std::string name_;
+    /// @brief Does the benchmark need the engine to be set up, with an OpenGL context and a Lua state?
+    bool requires_engine_;
+    /// @brief Builds what the benchmark operates on, and returns the function that runs the operation.
+    BenchmarkSetup setup_;
+    /// @brief Cleans up after the benchmark, if needed.
+    BenchmarkTeardown teardown_;
+  };
+
+  /// @brief The timings of a benchmark, all in nanoseconds (ns) per iteration.
+  struct BenchmarkResult {
+    /// @brief The name of the benchmark.
+    std::string name_;
+    /// @brief Was the benchmark skipped, because the engine couldn't be set up?
+    bool skipped_;
+    /// @brief The number of iterations in each sample.
+    uint64_t iterations_;
+    /// @brief The median time of the samples.
+    double median_;
+    /// @brief The fastest time of the samples.
+    double min_;
+    /// @brief The slowest time of the samples.
+    double max_;
+  };
+
+  /// @brief The registered benchmarks, in the order they were registered.
+  inline BenchmarkList benchmark_list;
+
+  /**
+   * @brief Registers a benchmark to be run.
+   * 
+   * @param[in] name            The name of the benchmark.
+   * @param[in] requires_engine Does the benchmark need the engine to be set up?
+   * @param[in] setup           Builds what the benchmark operates on, and returns the function that runs the operation being benchmarked the given number of times.
+   * @param[in] teardown        Cleans up anything that the setup added to the engine, if needed.
+   */
+  void RegisterBenchmark(const std::string& name, bool requires_engine, const BenchmarkSetup& setup, const BenchmarkTeardown& teardown = nullptr);
+
+  /**
+   * @brief Runs a benchmark, and measures how long each iteration takes.
+   * @details The benchmark is set up once, and then run with an increasing number of iterations until a sample takes at least _BENCHMARK_MIN_SAMPLE_TIME_, and then _BENCHMARK_SAMPLES_ samples are taken with that many iterations.
+   *          Only the operation is timed, so the setup and teardown don't count towards the results.
+   * 
+   * @param[in] benchmark The benchmark to run.
+   * @returns The timings of the benchmark.
+   */
+  BenchmarkResult RunBenchmark(const Benchmark& benchmark);
+
+  /**
+   * @brief Writes the results as JSON.
+   * @details The results are sorted by name and written with a fixed layout and precision, so that the output of two runs can be compared line by line.
+   * 
+   * @param[in] stream  The stream to write to.
+   * @param[in] results The results to write.
+   */
+  void WriteResults(std::ostream& stream, BenchmarkResultList results);
+
+  /**
+   * @brief Stops the compiler from optimising away a value that a benchmark computes, but doesn't otherwise use.
+   * 
+   * @param[in] value The value to keep.
+   */
+  template<typename T>
+  void KeepValue(const T& value)
+  {
+    static const void* volatile sink;
+
+    sink = static_cast<const void*>(&value);
+  }
+
+  /// @brief Registers the benchmarks for character maps.
+  void RegisterCharacterMapBenchmarks();
+
+  /// @brief Registers the benchmarks for game objects and event listeners.
+  void RegisterObjectBenchmarks();
+
+  /// @brief Registers the benchmarks for fonts and texture packing.
+  void RegisterResourceBenchmarks();
+}
+
+#endif // ! BENCHMARK_H
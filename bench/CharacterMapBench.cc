@@ -0,0 +1,101 @@
+#include <memory>
+#include <random>
+#include "Benchmark.h"
+#include "rendering/Buffer.h"
+#include "scripting/ScriptingInterface.h"
+#include "usertypes/CharacterMap.h"
+#include "usertypes/resources/Font.h"
+
+namespace term_engine::bench {
+  /// @brief The size of the character maps drawn in the benchmarks, which is roughly the size of a full-screen window.
+  constexpr glm::ivec2 BENCH_MAP_SIZE = glm::ivec2(160, 45);
+  /// @brief The size of the character maps pushed onto other maps in the benchmarks.
+  constexpr glm::ivec2 BENCH_PUSH_SIZE = glm::ivec2(16, 8);
+
+  /**
+   * @brief Creates a character map filled with random printable characters and colours.
+   * @details The same seed is always used, so that every run benchmarks the same data.
+   * 
+   * @param[in] size The size of the character map.
+   * @returns A unique pointer to the character map.
+   */
+  std::unique_ptr<usertypes::CharacterMap> CreateRandomCharacterMap(const glm::ivec2& size)
+  {
+    std::mt19937 generator(size.x * size.y);
+    std::uniform_int_distribution<int> character_distribution(' ', '~');
+    std::uniform_real_distribution<float> colour_distribution(0.0f, 255.0f);
+
+    std::unique_ptr<usertypes::CharacterMap> character_map = std::make_unique<usertypes::CharacterMap>();
+    character_map->SetSize(size);
+
+    for (usertypes::Character& character : character_map->GetData())
+    {
+      character.character_ = (char16_t)character_distribution(generator);
+      character.foreground_colour_ = glm::vec4(colour_distribution(generator), colour_distribution(generator), colour_distribution(generator), 255.0f);
+      character.background_colour_ = glm::vec4(colour_distribution(generator), colour_distribution(generator), colour_distribution(generator), 255.0f);
+    }
+
+    return character_map;
+  }
+
+  void RegisterCharacterMapBenchmarks()
+  {
+    RegisterBenchmark("CharacterMap::Clear", false, []() -> BenchmarkFunction {
+      std::shared_ptr<usertypes::CharacterMap> character_map = CreateRandomCharacterMap(BENCH_MAP_SIZE);
+
+      return [character_map](uint64_t iterations) {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          character_map->Clear();
+          KeepValue(character_map->GetData());
+        }
+      };
+    });
+
+    RegisterBenchmark("CharacterMap::PushCharacters", false, []() -> BenchmarkFunction {
+      std::shared_ptr<usertypes::CharacterMap> character_map = CreateRandomCharacterMap(BENCH_MAP_SIZE);
+      std::shared_ptr<usertypes::CharacterMap> push_map = CreateRandomCharacterMap(BENCH_PUSH_SIZE);
+
+      return [character_map, push_map, position = glm::ivec2(0)](uint64_t iterations) mutable {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          character_map->PushCharacters(position, *push_map);
+          KeepValue(character_map->GetData());
+
+          // Move across the map, so that pushes at the edges are clipped like they are when drawing objects.
+          position.x = (position.x + 7) % BENCH_MAP_SIZE.x;
+          position.y = (position.y + 3) % BENCH_MAP_SIZE.y;
+        }
+      };
+    });
+
+    RegisterBenchmark("CharacterMap::CopyToBuffer", true, []() -> BenchmarkFunction {
+      std::shared_ptr<usertypes::CharacterMap> character_map = CreateRandomCharacterMap(BENCH_MAP_SIZE);
+      usertypes::Font* font = usertypes::LoadFont(std::string(usertypes::DEFAULT_FONT));
+
+      return [character_map, font, buffer = rendering::BufferList()](uint64_t iterations) mutable {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          buffer.clear();
+          usertypes::CharacterMap::CopyToBuffer(character_map.get(), glm::ivec2(0), buffer, font, usertypes::DEFAULT_FONT_SIZE);
+          KeepValue(buffer);
+        }
+      };
+    });
+
+    RegisterBenchmark("CharacterMap::SetFunction", true, []() -> BenchmarkFunction {
+      std::shared_ptr<usertypes::CharacterMap> character_map = std::make_shared<usertypes::CharacterMap>();
+      character_map->SetSize(BENCH_MAP_SIZE);
+
+      const sol::function function = scripting::lua_state->script("return function(_, index) return Character(string.char(32 + index % 95), Colours.WHITE, Colours.BLACK) end");
+
+      return [character_map, function](uint64_t iterations) {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          character_map->SetFunction(function);
+          KeepValue(character_map->GetData());
+        }
+      };
+    });
+  }
+}
@@ -0,0 +1,79 @@
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+#include "Benchmark.h"
+#include "events/Listener.h"
+#include "scripting/ScriptingInterface.h"
+#include "usertypes/EventListener.h"
+#include "usertypes/Flaggable.h"
+#include "usertypes/GameScene.h"
+#include "usertypes/game_objects/GameObject.h"
+
+namespace term_engine::bench {
+  /// @brief The name of the game scene that the benchmarks add objects to.
+  constexpr char BENCH_GAME_SCENE_NAME[] = "bench";
+  /// @brief The number of game objects in the game scene. This matches the layer_benchmark example, so that changing layers is measured at the scale it was optimised for.
+  constexpr size_t BENCH_OBJECT_COUNT = 50000;
+  /// @brief The number of event listeners to dispatch events to.
+  constexpr size_t BENCH_LISTENER_COUNT = 64;
+  /// @brief The event types the listeners are spread between. Events are dispatched with the first type.
+  constexpr std::array<const char*, 4> BENCH_EVENT_TYPES = { "key_down", "key_up", "mouse_move", "mouse_down" };
+
+  void RegisterObjectBenchmarks()
+  {
+    // Game objects are drawn in layer order, so changing an object's layer moves it in the game scene's draw order.
+    RegisterBenchmark("GameObject::SetLayer", true, []() -> BenchmarkFunction {
+      std::mt19937 generator(BENCH_OBJECT_COUNT);
+      std::uniform_int_distribution<int32_t> layer_distribution(-100, 100);
+      std::uniform_int_distribution<int> position_distribution(0, 100);
+
+      usertypes::GameScene* game_scene = usertypes::AddGameScene(std::string(BENCH_GAME_SCENE_NAME));
+      std::vector<usertypes::GameObject*> game_objects;
+      std::vector<int32_t> layers;
+
+      for (size_t index = 0; index < BENCH_OBJECT_COUNT; ++index)
+      {
+        usertypes::GameObject* game_object = usertypes::AddGameObjectToScene(glm::ivec2(position_distribution(generator), position_distribution(generator)), glm::ivec2(4, 2), game_scene);
+        game_object->SetLayer(layer_distribution(generator));
+
+        game_objects.push_back(game_object);
+        layers.push_back(layer_distribution(generator));
+      }
+
+      return [game_scene, game_objects, layers](uint64_t iterations) {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          game_objects[iteration % BENCH_OBJECT_COUNT]->SetLayer(layers[iteration % BENCH_OBJECT_COUNT] + (int32_t)(iteration / BENCH_OBJECT_COUNT % 2));
+        }
+
+        KeepValue(game_scene->GetDrawOrder());
+      };
+    }, []() {
+      usertypes::GetGameSceneByName(BENCH_GAME_SCENE_NAME)->FlagForRemoval();
+      usertypes::ClearRemovalQueue();
+    });
+
+    RegisterBenchmark("EventListener::DoEvents", true, []() -> BenchmarkFunction {
+      const sol::protected_function callback = scripting::lua_state->script("return function(listener, data) return data.key end");
+      std::shared_ptr<std::vector<usertypes::EventListenerPtr>> listeners = std::make_shared<std::vector<usertypes::EventListenerPtr>>();
+
+      for (size_t index = 0; index < BENCH_LISTENER_COUNT; ++index)
+      {
+        listeners->emplace_back(std::make_unique<usertypes::EventListener>(std::string(BENCH_EVENT_TYPES[index % BENCH_EVENT_TYPES.size()]), callback));
+      }
+
+      const events::Event event(std::string(BENCH_EVENT_TYPES[0]), nullptr, scripting::lua_state->create_table_with("key", "a"));
+
+      return [listeners, event](uint64_t iterations) {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          for (usertypes::EventListenerPtr& listener : *listeners)
+          {
+            listener->DoEvents(event);
+          }
+        }
+      };
+    });
+  }
+}
@@ -0,0 +1,44 @@
+#include <memory>
+#include <vector>
+#include "Benchmark.h"
+#include "rendering/TexturePacker.h"
+#include "usertypes/resources/Font.h"
+
+namespace term_engine::bench {
+  /// @brief The size of the glyphs packed into textures in the benchmarks, in pixels (px).
+  constexpr glm::ivec2 BENCH_GLYPH_SIZE = glm::ivec2(12, 20);
+  /// @brief The number of glyphs packed into each texture, which is enough for the texture to be resized a few times.
+  constexpr size_t BENCH_GLYPHS_PER_TEXTURE = 1024;
+
+  void RegisterResourceBenchmarks()
+  {
+    // Each iteration packs a whole texture, so that the packer's tree grows and resizes like it does when a font is used.
+    RegisterBenchmark("TexturePacker::Insert/1024", false, []() -> BenchmarkFunction {
+      std::vector<uint8_t> glyph_data(BENCH_GLYPH_SIZE.x * BENCH_GLYPH_SIZE.y, 255);
+
+      return [glyph_data](uint64_t iterations) mutable {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          std::unique_ptr<rendering::TexturePacker> packer = std::make_unique<rendering::TexturePacker>();
+
+          for (size_t glyph = 0; glyph < BENCH_GLYPHS_PER_TEXTURE; ++glyph)
+          {
+            KeepValue(packer->Insert(glyph_data.data(), BENCH_GLYPH_SIZE));
+          }
+        }
+      };
+    });
+
+    // The glyphs are rendered on the first call, so this measures looking up glyphs that are already in the font's texture.
+    RegisterBenchmark("Font::GetCharacter", true, []() -> BenchmarkFunction {
+      usertypes::Font* font = usertypes::LoadFont(std::string(usertypes::DEFAULT_FONT));
+
+      return [font](uint64_t iterations) {
+        for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          KeepValue(font->GetCharacter((char16_t)(' ' + iteration % 95), usertypes::DEFAULT_FONT_SIZE));
+        }
+      };
+    });
+  }
+}
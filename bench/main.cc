@@ -0,0 +1,150 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <cxxopts.hpp>
+#include "Application.h"
+#include "Benchmark.h"
+#include "events/Listener.h"
+#include "scripting/ScriptingInterface.h"
+#include "system/CLArguments.h"
+#include "system/FPSManager.h"
+#include "usertypes/Window.h"
+#include "utility/FTUtils.h"
+#include "utility/GLUtils.h"
+#include "utility/JobSystem.h"
+#include "utility/SDLUtils.h"
+
+using namespace term_engine;
+
+/**
+ * @brief Sets up the parts of the engine that the benchmarks use, with a hidden window and no sound.
+ * @details The render thread isn't started, so that any OpenGL calls are made on this thread.
+ * 
+ * @returns If the engine was successfully set up.
+ */
+bool InitBenchEngine()
+{
+  utility::UseHeadlessDrivers();
+  system::use_render_thread = false;
+
+  if (!utility::InitSDL() || !utility::InitFreeType())
+  {
+    return false;
+  }
+
+  utility::InitGL();
+
+  if (!usertypes::InitDefaultWindow())
+  {
+    return false;
+  }
+
+  events::InitList();
+  system::InitFPS();
+  utility::InitJobSystem();
+
+  scripting::SetNextProject("");
+  InitProject();
+
+  return true;
+}
+
+/// @brief Cleans up the parts of the engine that the benchmarks use.
+void CleanUpBenchEngine()
+{
+  CleanUpProject();
+
+  utility::CleanUpJobSystem();
+  utility::CleanUpFreeType();
+  utility::CleanUpSDL();
+  usertypes::CleanUpDefaultWindow();
+}
+
+/**
+ * @brief The entrypoint of the benchmark suite.
+ * 
+ * @param[in] argc The amount of arguments passed to the program on startup.
+ * @param[in] argv An array pointer to a list of string pointers. The first element is always the program name.
+ * @returns A status code indicating how the program ended.
+ */
+int main(int argc, char** argv) {
+  cxxopts::Options options("TermEngineBench", "Microbenchmarks of the engine's hot paths.");
+  options.add_options()
+    ("filter", "Only run benchmarks with names containing this text.", cxxopts::value<std::string>()->default_value(""))
+    ("output", "The file to write the results to, as JSON.", cxxopts::value<std::string>()->default_value("bench_results.json"))
+    ("cpu-only", "Skip the benchmarks that need an OpenGL context and a Lua state?", cxxopts::value<bool>());
+
+  std::string filter;
+  std::string output_path;
+  bool cpu_only;
+
+  try
+  {
+    auto result = options.parse(argc, argv);
+
+    filter = result["filter"].as<std::string>();
+    output_path = result["output"].as<std::string>();
+    cpu_only = result["cpu-only"].as<bool>();
+  }
+  catch (cxxopts::exceptions::exception& ex)
+  {
+    std::cerr << "Failed to parse command-line arguments. Error: " << ex.what() << std::endl;
+
+    return 1;
+  }
+
+  utility::InitLogger();
+
+  bench::RegisterCharacterMapBenchmarks();
+  bench::RegisterObjectBenchmarks();
+  bench::RegisterResourceBenchmarks();
+
+  const bool engine_ready = !cpu_only && InitBenchEngine();
+
+  if (!cpu_only && !engine_ready)
+  {
+    utility::LogWarn("Failed to set up the engine! Benchmarks that need it will be skipped.");
+  }
+
+  bench::BenchmarkResultList results;
+
+  for (const bench::Benchmark& benchmark : bench::benchmark_list)
+  {
+    if (benchmark.name_.find(filter) == std::string::npos)
+    {
+      continue;
+    }
+
+    if (benchmark.requires_engine_ && !engine_ready)
+    {
+      results.push_back({ benchmark.name_, true, 0, 0.0, 0.0, 0.0 });
+
+      continue;
+    }
+
+    const bench::BenchmarkResult result = bench::RunBenchmark(benchmark);
+    utility::LogInfo("{}: {:.3f}ns (min {:.3f}ns, max {:.3f}ns, {} iterations)", result.name_, result.median_, result.min_, result.max_, result.iterations_);
+
+    results.push_back(result);
+  }
+
+  std::ofstream output_file(output_path, std::ios::trunc);
+
+  if (output_file.is_open())
+  {
+    bench::WriteResults(output_file, results);
+  }
+  else
+  {
+    utility::LogError("Failed to open \"{}\" to write the results to!", output_path);
+  }
+
+  if (engine_ready)
+  {
+    CleanUpBenchEngine();
+  }
+
+  utility::ShutdownLogger();
+
+  return output_file.is_open() ? 0 : 1;
+}
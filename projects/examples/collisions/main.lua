@@ -0,0 +1,34 @@
+local player
+local walls = {}
+local collision_listener
+
+function Init()
+  player = GameObject(Ivec2(2, 2), Ivec2(3, 3))
+  player:set(function(_, index)
+    -- Only the middle row is solid, so the player collides by its characters rather than its whole area.
+    if index >= 4 and index <= 6 then
+      return Character("@", Colours.GREEN, Colours.BLACK)
+    else
+      return Character(characters.NO_CHARACTER, Colours.BLACK, Colours.BLACK)
+    end
+  end)
+  player.collision = collisionMode.CELL
+
+  for i = 1, 10 do
+    local wall = GameObject(Ivec2(math.random(10, 70), math.random(0, 22)), Ivec2(2, 2))
+    wall:set(function(_, _) return Character("#", Colours.WHITE, Colours.BLACK) end)
+    wall.collision = collisionMode.RECT
+    walls[i] = wall
+  end
+
+  -- Collision events are sent once per pair of objects, when they start and stop colliding.
+  collision_listener = EventListener("object_collision", function(_, data)
+    print("Objects " .. data.id .. " and " .. data.other_id .. " " .. (data.type == "enter" and "started" or "stopped") .. " colliding.")
+  end)
+
+  return true
+end
+
+function Loop(timestep)
+  player.position = Ivec2((player.position.x + 1) % 80, player.position.y)
+end
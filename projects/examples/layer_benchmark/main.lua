@@ -0,0 +1,32 @@
+local OBJECT_COUNT = 50000
+local LAYER_COUNT = 16
+
+local objects = {}
+local fpsText
+
+function Init()
+  -- Remove the frame rate limit, so the average FPS shows how long each frame takes.
+  fps.target(0)
+
+  -- The objects fill the window below the top row, which is left for the FPS counter.
+  for i = 1, OBJECT_COUNT do
+    local obj = GameObject(Ivec2((i - 1) % 80, 1 + math.floor((i - 1) / 80) % 24), Values.IVEC2_ONE)
+    obj:set(function(_, _) return Character("#", Colours.WHITE, Colours.BLACK) end)
+    obj.layer = i % LAYER_COUNT
+
+    objects[i] = obj
+  end
+
+  fpsText = TextObject(Values.IVEC2_ZERO, Ivec2(24, 1))
+
+  return true
+end
+
+function Loop(timestep)
+  -- Move every object to a random layer each frame. Game objects are kept in layer order as they change, so this does not cause a re-sort.
+  for i = 1, OBJECT_COUNT do
+    objects[i].layer = math.random(0, LAYER_COUNT - 1)
+  end
+
+  fpsText.text = "FPS: "..string.sub(fps.getAverage(), 0, 10)
+end
@@ -0,0 +1,42 @@
+local spark
+local sparks = {}
+local released_spark
+
+function Init()
+  -- Create the pool of objects up-front, so that spawning doesn't need to create any.
+  GameObject.reserve(500)
+
+  -- This object is used as the template for each spark. Its character data is shared with each copy until it is changed.
+  spark = GameObject(Values.IVEC2_ZERO, Values.IVEC2_ONE)
+  spark:set(function(_, _) return Character("*", Colours.YELLOW, Colours.BLACK) end)
+  spark.active = false
+
+  return true
+end
+
+function Loop(timestep)
+  -- The spark released last frame is back in the pool, and may have been reused. The old reference must not reach whichever spark reuses it.
+  if released_spark ~= nil then
+    assert(not pcall(function() return released_spark.position end), "A released spark can still be reached through an old reference!")
+  end
+
+  -- Release last frame's sparks, which puts them back in the pool.
+  for _, obj in ipairs(sparks) do
+    obj:release()
+  end
+
+  released_spark = sparks[1]
+
+  local positions = {}
+
+  for i = 1, 100 do
+    positions[i] = Ivec2(math.random(0, 79), math.random(0, 24))
+  end
+
+  -- Spawn a copy of the template at each position, reusing the released sparks.
+  sparks = GameObject.spawnMany(spark, positions)
+
+  for _, obj in ipairs(sparks) do
+    obj.active = true
+  end
+end
@@ -0,0 +1,35 @@
+function Init()
+  for i = 1, 20 do
+    local obj = GameObject(Ivec2(math.random(0, 79), math.random(0, 24)), Values.IVEC2_ONE)
+    obj:set(function(_, _) return Character("E", Colours.RED, Colours.BLACK) end)
+    obj:addTag("enemy")
+
+    -- Components are tags that carry a value, so they can be queried in the same way.
+    if i % 2 == 0 then
+      obj:setComponent("velocity", Ivec2(1, 0))
+    end
+  end
+
+  for i = 1, 5 do
+    local obj = GameObject(Ivec2(math.random(0, 79), math.random(0, 24)), Values.IVEC2_ONE)
+    obj:set(function(_, _) return Character("C", Colours.CYAN, Colours.BLACK) end)
+    obj:setComponent("velocity", Ivec2(0, 1))
+  end
+
+  return true
+end
+
+function Loop(timestep)
+  -- Only objects with a velocity are visited, without building a table of them.
+  for obj in GameObject.query("velocity") do
+    local velocity = obj:getComponent("velocity")
+    obj.position = Ivec2((obj.position.x + velocity.x) % 80, (obj.position.y + velocity.y) % 25)
+  end
+
+  -- Moving enemies stop once they reach the left-most column.
+  for obj in GameObject.query("enemy", "velocity") do
+    if obj.position.x == 0 then
+      obj:removeComponent("velocity")
+    end
+  end
+end
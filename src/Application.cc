@@ -2,19 +2,26 @@
 #include "Application.h"
 #include "events/InputManager.h"
 #include "events/Listener.h"
+#include "rendering/RenderThread.h"
 #include "scripting/ScriptingInterface.h"
 #include "system/CLArguments.h"
 #include "system/FPSManager.h"
+#include "system/InputRecorder.h"
+#include "system/Profiler.h"
+#include "system/Tracer.h"
 #include "usertypes/EventListener.h"
+#include "usertypes/Flaggable.h"
 #include "usertypes/GameScene.h"
 #include "usertypes/GameWindow.h"
 #include "usertypes/Window.h"
 #include "usertypes/game_objects/BaseObject.h"
+#include "usertypes/game_objects/TimedFunction.h"
 #include "usertypes/resources/BaseResource.h"
 #include "utility/AudioUtils.h"
 #include "utility/FTUtils.h"
 #include "utility/GLUtils.h"
 #include "utility/ImGuiUtils.h"
+#include "utility/JobSystem.h"
 #include "utility/SDLUtils.h"
 #include "utility/LogUtils.h"
 
@@ -23,6 +30,12 @@ namespace term_engine {
   {
     utility::InitLogger();
     system::GetCLArguments(argc, argv);
+    system::InitTracer();
+
+    if (system::headless_mode)
+    {
+      utility::UseHeadlessDrivers();
+    }
 
     if (!utility::InitSDL() || !utility::InitFreeType() || !utility::InitAudio())
     {
@@ -39,8 +52,12 @@ namespace term_engine {
       exit(3);
     }
 
+    rendering::InitRenderThread(usertypes::default_window->GetWindow());
     events::InitList();
     system::InitFPS();
+    system::InitProfiler();
+    system::InitInputRecorder();
+    utility::InitJobSystem();
 
     scripting::SetNextProject(system::scriptPath.string());
     InitProject();
@@ -52,6 +69,7 @@ namespace term_engine {
   {
     events::Init();
     scripting::Setup();
+    system::ApplyRecordingSeed();
 
     SDL_StopTextInput();
   }
@@ -60,6 +78,11 @@ namespace term_engine {
   {
     CleanUpProject();
 
+    rendering::CleanUpRenderThread();
+    system::CleanUpInputRecorder();
+    system::CleanUpProfiler();
+    system::CleanUpTracer();
+    utility::CleanUpJobSystem();
     utility::CleanUpAudio();
     utility::CleanUpFreeType();
     utility::CleanUpSDL();
@@ -73,11 +96,12 @@ namespace term_engine {
 
   void CleanUpProject()
   {
+    rendering::WaitForRenderThread();
     events::CleanUpList();
+    usertypes::ClearAllObjects();
     usertypes::ClearAllGameWindows();
     usertypes::ClearAllGameScenes();
     usertypes::ClearAllEventListeners();
-    usertypes::ClearAllObjects();
     scripting::Shutdown();
     usertypes::CleanUpResources();
     events::CleanUp();
@@ -114,62 +138,154 @@ namespace term_engine {
         }
       }
 
-      // Using the side-effect of SDL_QuitRequested() calling SDL_PumpEvents() to omit it from the below code.
-      if (SDL_QuitRequested() || usertypes::GameWindow::IsQuitting())
+      // If nothing is animating and no frame was requested, nothing can change until an event arrives or a timed function is due.
+      if (!system::IsReplaying() && system::IsIdleModeEnabled() && !system::TakeRedrawRequest() && !usertypes::HasAnimatingGameObjects())
+      {
+        system::WaitForEvents(usertypes::GetTimeUntilNextTimedFunction());
+      }
+
+      {
+        system::ProfileScope scope(system::ProfileZone::EVENT_PUMP);
+
+        if (system::IsReplaying())
+        {
+          // Replays stop once they run out of recorded frames.
+          quit = !system::StartInputFrame() || usertypes::GameWindow::IsQuitting();
+        }
+        else
+        {
+          // Using the side-effect of SDL_QuitRequested() calling SDL_PumpEvents() to omit it from the below code.
+          quit = SDL_QuitRequested() || usertypes::GameWindow::IsQuitting();
+          system::StartInputFrame();
+        }
+      }
+
+      if (quit)
       {
         scripting::OnQuit();
 
         break;
       }
 
-      events::UpdateInputState();
+      {
+        system::ProfileScope scope(system::ProfileZone::SDL_EVENTS);
 
-      SDL_Event event;
+        if (system::IsReplaying())
+        {
+          system::ReplayInputState();
+        }
+        else
+        {
+          events::UpdateInputState();
+          system::RecordInputState();
+        }
 
-      while (SDL_PollEvent(&event) != 0) {
-        utility::ImGui_DoEvents(event);
-        utility::LogKeyboardEvents(event);
-        utility::LogTextInputEvents(event);
-        utility::LogWindowEvents(event);
+        SDL_Event event;
 
-        usertypes::DoGameWindowEvents(event);
-        events::DoSDLEvents(event);
+        while (system::PollEvent(event)) {
+          utility::ImGui_DoEvents(event);
+          utility::LogKeyboardEvents(event);
+          utility::LogTextInputEvents(event);
+          utility::LogWindowEvents(event);
+
+          usertypes::DoGameWindowEvents(event);
+          events::DoSDLEvents(event);
+        }
       }
 
-      for (const events::Event& event : events::event_list)
       {
-        for (usertypes::EventListenerPtr& listener : usertypes::listener_list)
+        system::ProfileScope scope(system::ProfileZone::LISTENERS);
+
+        for (const events::Event& event : events::event_list)
         {
-          listener->DoEvents(event);
+          for (usertypes::EventListenerPtr& listener : usertypes::listener_list)
+          {
+            listener->DoEvents(event);
+          }
         }
+
+        events::CleanUpList();
       }
 
-      events::CleanUpList();
+      timestep = system::RecordTimestep(timestep_timer.GetIntervalElapsedNs());
+
+      if (system::IsUsingFixedTimestep())
+      {
+        // If no tick is due this frame, the input state is left as it is so that presses/releases are still seen by the next tick.
+        const uint32_t ticks = system::AccumulateTicks(timestep);
+
+        for (uint32_t tick = 0; tick < ticks; ++tick)
+        {
+          Tick(system::GetTickDuration());
+        }
+      }
+      else
+      {
+        Tick(timestep);
+      }
 
-      timestep = timestep_timer.GetIntervalElapsed();
+      Render();
+
+      {
+        system::ProfileScope scope(system::ProfileZone::CLEANUP);
+
+        usertypes::ClearRemovalQueue();
+      }
+
+      {
+        system::ProfileScope scope(system::ProfileZone::IMGUI);
+
+        utility::ImGui_StartFrame();
+        utility::ImGui_UpdateInfo();
+        utility::ImGui_EndFrame();
+      }
+
+      system::NextFrame();
+      system::CalculateFPS();
+      system::EndInputFrame();
+
+      // Replays run as fast as possible, so the frame rate isn't capped.
+      if (!system::IsReplaying())
+      {
+        system::Delay();
+      }
+
+      system::EndProfileFrame(system::GetFrameCount());
+    }
+  }
+
+  void Tick(uint64_t timestep)
+  {
+    {
+      system::ProfileScope scope(system::ProfileZone::ON_LOOP);
 
       scripting::OnLoop(timestep);
+    }
+
+    {
+      system::ProfileScope scope(system::ProfileZone::UPDATE_OBJECTS);
 
-      usertypes::SortObjects();
       usertypes::UpdateObjects(timestep);
       usertypes::UpdateGameWindows(timestep);
+    }
 
-      usertypes::ClearFlaggedEventListeners();
-      usertypes::ClearFlaggedObjects();
-      usertypes::ClearFlaggedGameScenes();
-      usertypes::ClearFlaggedGameWindows();
-      usertypes::ClearFlaggedResources();
+    events::UpdatePrevInputState();
+  }
 
-      utility::ImGui_StartFrame();
-      utility::ImGui_UpdateInfo();
-      utility::ImGui_EndFrame();
+  void Render()
+  {
+    {
+      system::ProfileScope scope(system::ProfileZone::ON_LOOP);
 
-      system::NextFrame();
+      scripting::OnRender(system::GetInterpolationAlpha());
+    }
 
-      events::UpdatePrevInputState();
+    {
+      system::ProfileScope scope(system::ProfileZone::VERTEX_BUILD);
 
-      system::CalculateFPS();
-      system::Delay();
+      usertypes::DrawGameScenes();
     }
+
+    usertypes::RenderGameWindows();
   }
 }
\ No newline at end of file
@@ -20,6 +20,16 @@ namespace term_engine {
 
   /// @brief Runs the application. This function will loop continuously until the 'quit' flag is set.
   void Run();
+
+  /**
+   * @brief Runs a single step of the simulation, i.e. the Lua loop functions and the objects.
+   * 
+   * @param[in] timestep The amount of time to simulate, in nanoseconds (ns).
+   */
+  void Tick(uint64_t timestep);
+
+  /// @brief Runs the Lua render function with the interpolation alpha, then draws the game scenes to their game windows.
+  void Render();
 }
 
 #endif // ! APPLICATION_H
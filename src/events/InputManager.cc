@@ -23,6 +23,9 @@ namespace term_engine::events {
     current_mouse_state = SDL_GetMouseState(&mouse_position.x, &mouse_position.y);
     SDL_GetRelativeMouseState(&mouse_position_delta.x, &mouse_position_delta.y);
     current_key_state = SDL_GetKeyboardState(nullptr);
+
+    SDL_Window* mouse_focus = SDL_GetMouseFocus();
+    mouse_focus_window_id = mouse_focus != nullptr ? SDL_GetWindowID(mouse_focus) : 0;
   }
 
   void UpdatePrevInputState()
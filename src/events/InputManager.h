@@ -31,6 +31,8 @@ namespace term_engine::events {
   inline glm::ivec2 mouse_position;
   /// @brief Represents how far the mouse has moved within the window.
   inline glm::ivec2 mouse_position_delta;
+  /// @brief The ID of the window that has mouse focus, or 0 if no window has it.
+  inline Uint32 mouse_focus_window_id = 0;
 
   /// @brief Prepares the keyboard states for use.
   void Init();
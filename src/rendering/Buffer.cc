@@ -43,20 +43,25 @@ namespace term_engine::rendering {
   }
 
   void Buffer::PushToGL()
+  {
+    PushToGL(data);
+  }
+
+  void Buffer::PushToGL(const BufferList& buffer_data)
   {
     glBindVertexArray(vao_id_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_id_);
 
     // If the size of the buffer has changed, recreate the OpenGL buffer with the new size.
-    if (current_data_size_ != data.size())
+    if (current_data_size_ != buffer_data.size())
     {
-      current_data_size_ = data.size();
-      glBufferData(GL_ARRAY_BUFFER, sizeof(BufferData) * current_data_size_, data.data(), GL_STREAM_DRAW);
+      current_data_size_ = buffer_data.size();
+      glBufferData(GL_ARRAY_BUFFER, sizeof(BufferData) * current_data_size_, buffer_data.data(), GL_STREAM_DRAW);
 
       utility::LogDebug("Resized buffer at VAO {} to {} items...", vao_id_, current_data_size_);
     }
 
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(BufferData) * current_data_size_, data.data());
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(BufferData) * current_data_size_, buffer_data.data());
   }
 
   void Buffer::Use() const
@@ -68,6 +68,13 @@ namespace term_engine::rendering {
     /// @brief Pushes the buffer data to the VBO.
     void PushToGL();
 
+    /**
+     * @brief Pushes the given buffer data to the VBO, instead of the buffer's own data.
+     * 
+     * @param[in] buffer_data The buffer data to push.
+     */
+    void PushToGL(const BufferList& buffer_data);
+
     /// @brief Binds the buffer.
     void Use() const;
 
@@ -0,0 +1,53 @@
+/// @author James Holtom
+
+#ifndef FRAME_PACKET_H
+#define FRAME_PACKET_H
+
+#include <vector>
+#include "Buffer.h"
+#include "Texture.h"
+#include "../utility/GLUtils.h"
+
+namespace term_engine::rendering {
+  struct FramePacket;
+
+  /// @brief Used to store the frame packets for each window being drawn in a frame.
+  typedef std::vector<FramePacket> FramePacketList;
+
+  /**
+   * @brief Contains everything needed to draw a window for a single frame.
+   * @details Packets are built on the main thread, and are not changed once they are handed to the render thread. Resources are referred to by their OpenGL IDs, so that the render thread never touches the resources themselves.
+   */
+  struct FramePacket {
+    /// @brief The SDL handle to the window to draw to.
+    SDL_Window* window_;
+    /// @brief The ID of the window to draw to.
+    uint32_t window_id_;
+    /// @brief The size of the window, in pixels (px).
+    glm::ivec2 size_;
+    /// @brief The colour to clear the window with.
+    glm::vec4 clear_colour_;
+    /// @brief The polygon mode to draw with, i.e. _GL_FILL_, or _GL_LINE_ for wireframe rendering.
+    uint32_t render_mode_;
+    /// @brief The vsync flag to swap the window with.
+    int vsync_flag_;
+    /// @brief The projection matrix for the size of the window.
+    glm::mat4 projection_;
+    /// @brief Does the window have a background to draw?
+    bool has_background_;
+    /// @brief The texture of the background.
+    TextureData background_texture_;
+    /// @brief The ID of the shader program to draw the background with.
+    uint32_t background_program_id_;
+    /// @brief The vertex data of the background.
+    BufferList background_data_;
+    /// @brief The texture of the font atlas.
+    TextureData font_texture_;
+    /// @brief The ID of the shader program to draw the text with.
+    uint32_t text_program_id_;
+    /// @brief The vertex data of the character map, as it was when the packet was built.
+    BufferList text_data_;
+  };
+}
+
+#endif // ! FRAME_PACKET_H
@@ -0,0 +1,254 @@
+#include "RenderThread.h"
+#include "../system/CLArguments.h"
+#include "../system/Profiler.h"
+#include "../utility/LogUtils.h"
+
+namespace term_engine::rendering {
+  RenderThread::RenderThread(SDL_GLContext context, SDL_Window* window) :
+    build_index_(0),
+    frame_fence_(nullptr),
+    has_frame_(false),
+    is_rendering_(false),
+    is_stopping_(false),
+    context_(context),
+    window_(window)
+  {
+    thread_ = std::thread(&RenderThread::Run, this);
+
+    utility::LogDebug("Started render thread.");
+  }
+
+  RenderThread::~RenderThread()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopping_ = true;
+    }
+
+    frame_cv_.notify_all();
+    thread_.join();
+
+    if (frame_fence_ != nullptr)
+    {
+      glDeleteSync(frame_fence_);
+    }
+
+    SDL_GL_DeleteContext(context_);
+
+    utility::LogDebug("Stopped render thread.");
+  }
+
+  FramePacketList& RenderThread::GetBuildPackets()
+  {
+    return packets_[build_index_];
+  }
+
+  void RenderThread::SubmitFrame()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return !has_frame_ && !is_rendering_; });
+
+    // The render thread waits on the fence, so that it sees the textures and uniforms updated on the main thread before the frame was submitted.
+    frame_fence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    build_index_ = 1 - build_index_;
+    has_frame_ = true;
+
+    lock.unlock();
+    frame_cv_.notify_one();
+  }
+
+  void RenderThread::WaitForFrame()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return !has_frame_ && !is_rendering_; });
+  }
+
+  void RenderThread::Run()
+  {
+    SDL_GL_MakeCurrent(window_, context_);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    while (true)
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      frame_cv_.wait(lock, [this]() { return has_frame_ || is_stopping_; });
+
+      if (is_stopping_)
+      {
+        break;
+      }
+
+      const FramePacketList& packets = packets_[1 - build_index_];
+      GLsync fence = frame_fence_;
+      frame_fence_ = nullptr;
+      has_frame_ = false;
+      is_rendering_ = true;
+
+      lock.unlock();
+
+      glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+      glDeleteSync(fence);
+
+      SubmitFramePackets(packets, context_, targets_);
+
+      lock.lock();
+      is_rendering_ = false;
+      lock.unlock();
+
+      done_cv_.notify_all();
+    }
+
+    // The render targets belong to this thread's context, so they are deleted before it is released.
+    SDL_GL_MakeCurrent(window_, context_);
+    targets_.clear();
+    SDL_GL_MakeCurrent(window_, nullptr);
+  }
+
+  void InitRenderThread(SDL_Window* window)
+  {
+    if (!system::use_render_thread)
+    {
+      utility::LogDebug("Render thread is disabled, so frames will be drawn on the main thread.");
+
+      return;
+    }
+
+#if defined(__APPLE__)
+    // macOS only allows OpenGL contexts to draw to and swap windows on the main thread.
+    system::use_render_thread = false;
+    utility::LogDebug("Render thread isn't supported on macOS, so frames will be drawn on the main thread.");
+
+    return;
+#endif
+
+    // Creating a context makes it current, so the main thread's context is made current again afterwards.
+    SDL_GL_MakeCurrent(window, utility::context);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    SDL_GLContext render_context = SDL_GL_CreateContext(window);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+    SDL_GL_MakeCurrent(window, utility::context);
+
+    if (render_context == nullptr)
+    {
+      utility::LogWarn("Failed to create the render thread's context, so frames will be drawn on the main thread: {}", SDL_GetError());
+
+      return;
+    }
+
+    render_thread = std::make_unique<RenderThread>(render_context, window);
+  }
+
+  void CleanUpRenderThread()
+  {
+    render_thread.reset();
+    render_targets.clear();
+    frame_packets.clear();
+  }
+
+  FramePacketList& GetFramePackets()
+  {
+    return render_thread ? render_thread->GetBuildPackets() : frame_packets;
+  }
+
+  void SubmitFrame()
+  {
+    if (render_thread)
+    {
+      render_thread->SubmitFrame();
+    }
+    else
+    {
+      SubmitFramePackets(frame_packets, utility::context, render_targets);
+    }
+  }
+
+  void WaitForRenderThread()
+  {
+    if (render_thread)
+    {
+      render_thread->WaitForFrame();
+    }
+  }
+
+  void SubmitFramePackets(const FramePacketList& packets, SDL_GLContext context, RenderTargetList& targets)
+  {
+    for (auto& [ _, target ] : targets)
+    {
+      target->is_used_ = false;
+    }
+
+    for (const FramePacket& packet : packets)
+    {
+      SDL_GL_MakeCurrent(packet.window_, context);
+
+      RenderTargetList::iterator it = targets.find(packet.window_id_);
+
+      if (it == targets.end())
+      {
+        it = targets.emplace(packet.window_id_, std::make_unique<RenderTarget>()).first;
+        it->second->vsync_flag_ = UNSET_VSYNC_FLAG;
+      }
+
+      it->second->is_used_ = true;
+
+      SubmitFramePacket(packet, *it->second);
+    }
+
+    // Windows that weren't drawn to have been closed or lost their game scene, so their buffers are no longer needed.
+    std::erase_if(targets, [](const auto& item) { return !item.second->is_used_; });
+  }
+
+  void SubmitFramePacket(const FramePacket& packet, RenderTarget& target)
+  {
+    {
+      system::ProfileScope scope(system::ProfileZone::GL_UPLOAD);
+
+      glViewport(0, 0, packet.size_.x, packet.size_.y);
+      glPolygonMode(GL_FRONT_AND_BACK, packet.render_mode_);
+      glClearColor(packet.clear_colour_.r / 255.0f, packet.clear_colour_.g / 255.0f, packet.clear_colour_.b / 255.0f, packet.clear_colour_.a / 255.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+
+      if (packet.has_background_)
+      {
+        target.background_buffer_.PushToGL(packet.background_data_);
+        target.background_buffer_.Use();
+
+        glActiveTexture(GL_TEXTURE0 + packet.background_texture_.texture_unit_);
+        glBindTexture(GL_TEXTURE_2D, packet.background_texture_.texture_id_);
+        glUseProgram(packet.background_program_id_);
+        glProgramUniformMatrix4fv(packet.background_program_id_, glGetUniformLocation(packet.background_program_id_, "projection"), 1, GL_FALSE, glm::value_ptr(packet.projection_));
+
+        glDrawArrays(GL_TRIANGLES, 0, packet.background_data_.size());
+      }
+
+      target.text_buffer_.PushToGL(packet.text_data_);
+      target.text_buffer_.Use();
+
+      glActiveTexture(GL_TEXTURE0 + packet.font_texture_.texture_unit_);
+      glBindTexture(GL_TEXTURE_2D, packet.font_texture_.texture_id_);
+      glUseProgram(packet.text_program_id_);
+      glProgramUniformMatrix4fv(packet.text_program_id_, glGetUniformLocation(packet.text_program_id_, "projection"), 1, GL_FALSE, glm::value_ptr(packet.projection_));
+
+      glDrawArrays(GL_TRIANGLES, 0, packet.text_data_.size());
+    }
+
+    // The swap interval belongs to each context, so it is set the first time a window is swapped and whenever it changes.
+    if (target.vsync_flag_ != packet.vsync_flag_)
+    {
+      if (SDL_GL_SetSwapInterval(packet.vsync_flag_) < 0 && packet.vsync_flag_ == -1)
+      {
+        SDL_GL_SetSwapInterval(1);
+      }
+
+      target.vsync_flag_ = packet.vsync_flag_;
+    }
+
+    system::ProfileScope scope(system::ProfileZone::SWAP);
+
+    SDL_GL_SwapWindow(packet.window_);
+  }
+}
@@ -0,0 +1,162 @@
+/// @author James Holtom
+
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "Buffer.h"
+#include "FramePacket.h"
+#include "../utility/GLUtils.h"
+
+namespace term_engine::rendering {
+  class RenderThread;
+  struct RenderTarget;
+
+  /// @brief The vsync flag given to render targets before their window has been swapped, which doesn't match any valid flag.
+  constexpr int UNSET_VSYNC_FLAG = 2;
+
+  /// @brief Unique pointer to a render thread.
+  typedef std::unique_ptr<RenderThread> RenderThreadPtr;
+  /// @brief Unique pointer to a render target.
+  typedef std::unique_ptr<RenderTarget> RenderTargetPtr;
+  /// @brief Used to store the render targets for each window, indexed by the window's ID.
+  typedef std::unordered_map<uint32_t, RenderTargetPtr> RenderTargetList;
+
+  /**
+   * @brief The OpenGL buffers used to draw a window.
+   * @note VAOs can't be shared between OpenGL contexts, so the buffers belong to whichever context submits the frame packets.
+   */
+  struct RenderTarget {
+    /// @brief The buffer used to draw the background.
+    Buffer background_buffer_;
+    /// @brief The buffer used to draw the text.
+    Buffer text_buffer_;
+    /// @brief The vsync flag the window was last swapped with.
+    int vsync_flag_;
+    /// @brief Was the target drawn to in the last frame?
+    bool is_used_;
+  };
+
+  /**
+   * @brief Submits frame packets to OpenGL and swaps the windows on a separate thread, so that the next frame can be simulated while the last one is drawn.
+   * @details The render thread has its own OpenGL context, which shares textures, buffers and shader programs with the main thread's context.
+   *          Frame packets are double-buffered, so that the main thread builds one set of packets while the render thread submits the other.
+   */
+  class RenderThread {
+  public:
+    /**
+     * @brief Constructs the render thread, and starts it.
+     * 
+     * @param[in] context The OpenGL context for the render thread to use, which must not be current on any other thread.
+     * @param[in] window  The SDL handle to a window to make the context current with when it starts.
+     */
+    RenderThread(SDL_GLContext context, SDL_Window* window);
+
+    /// @brief Stops and joins the render thread, and deletes its OpenGL context.
+    ~RenderThread();
+
+    /**
+     * @brief Returns the frame packets that the main thread builds the next frame into.
+     * 
+     * @returns The list of frame packets.
+     */
+    FramePacketList& GetBuildPackets();
+
+    /**
+     * @brief Hands the built frame packets to the render thread.
+     * @details If the render thread is still submitting the last frame, this waits for it to finish first.
+     */
+    void SubmitFrame();
+
+    /// @brief Waits until the render thread has finished submitting every frame it has been given.
+    void WaitForFrame();
+
+  protected:
+    /// @brief The render thread.
+    std::thread thread_;
+    /// @brief Guards the frame packets and the thread state.
+    std::mutex mutex_;
+    /// @brief Signals the render thread that a frame has been submitted, or that it should stop.
+    std::condition_variable frame_cv_;
+    /// @brief Signals that the render thread has finished submitting a frame.
+    std::condition_variable done_cv_;
+    /// @brief The two sets of frame packets, one of which is being built while the other is submitted.
+    std::array<FramePacketList, 2> packets_;
+    /// @brief The index of the set of frame packets being built.
+    size_t build_index_;
+    /// @brief Marks when the main thread's OpenGL commands for the submitted frame (e.g. font texture updates) have completed.
+    GLsync frame_fence_;
+    /// @brief Is there a frame waiting to be submitted?
+    bool has_frame_;
+    /// @brief Is the render thread submitting a frame?
+    bool is_rendering_;
+    /// @brief Should the render thread stop?
+    bool is_stopping_;
+    /// @brief The OpenGL context used by the render thread.
+    SDL_GLContext context_;
+    /// @brief The window to make the context current with when the thread starts.
+    SDL_Window* window_;
+    /// @brief The render targets for each window, which belong to the render thread's context.
+    RenderTargetList targets_;
+
+    /// @brief Waits for frames and submits them, until the render thread is stopped.
+    void Run();
+  };
+
+  /// @brief The render thread, if it has been started.
+  inline RenderThreadPtr render_thread;
+  /// @brief The frame packets built when frames are submitted on the main thread.
+  inline FramePacketList frame_packets;
+  /// @brief The render targets used when frames are submitted on the main thread.
+  inline RenderTargetList render_targets;
+
+  /**
+   * @brief Starts the render thread, with an OpenGL context that shares the main thread's resources.
+   * @note If the context can't be created, or on macOS (which only allows windows to be drawn to from the main thread), frames are submitted on the main thread instead.
+   * 
+   * @param[in] window The SDL handle to the window that the main thread's context was created with.
+   */
+  void InitRenderThread(SDL_Window* window);
+
+  /// @brief Stops the render thread, and deletes the render targets used on the main thread.
+  void CleanUpRenderThread();
+
+  /**
+   * @brief Returns the frame packets to build the next frame into.
+   * 
+   * @returns The list of frame packets.
+   */
+  FramePacketList& GetFramePackets();
+
+  /// @brief Submits the built frame packets, using the render thread if it has been started.
+  void SubmitFrame();
+
+  /// @brief Waits until every submitted frame has been drawn, so that windows and resources can be safely destroyed.
+  void WaitForRenderThread();
+
+  /**
+   * @brief Draws each frame packet to its window and swaps them, using the OpenGL context that is current on the calling thread.
+   * @details Render targets are created for new windows, and removed for windows that are no longer drawn to.
+   * 
+   * @param[in]     packets The frame packets to draw.
+   * @param[in]     context The OpenGL context that is current on the calling thread.
+   * @param[in,out] targets The render targets for each window.
+   */
+  void SubmitFramePackets(const FramePacketList& packets, SDL_GLContext context, RenderTargetList& targets);
+
+  /**
+   * @brief Draws a frame packet to its window and swaps it.
+   * @note The calling thread's OpenGL context must be current with the packet's window.
+   * 
+   * @param[in]     packet The frame packet to draw.
+   * @param[in,out] target The render target for the window.
+   */
+  void SubmitFramePacket(const FramePacket& packet, RenderTarget& target);
+}
+
+#endif // ! RENDER_THREAD_H
@@ -4,6 +4,7 @@
 #include "bindings/ObjectBindings.h"
 #include "bindings/UtilityBindings.h"
 #include "../system/FileFunctions.h"
+#include "../system/FPSManager.h"
 #include "../utility/LogUtils.h"
 
 namespace term_engine::scripting {
@@ -153,7 +154,7 @@ namespace term_engine::scripting {
   void OnLoop(uint64_t timestep)
   {
     try {
-      sol::protected_function_result result = (*lua_state)["Loop"](timestep);
+      sol::protected_function_result result = (*lua_state)["Loop"](system::ConvertTimestep(timestep));
 
       if (!result.valid())
       {
@@ -166,6 +167,22 @@ namespace term_engine::scripting {
     }
   }
 
+  void OnRender(double alpha)
+  {
+    try {
+      sol::protected_function_result result = (*lua_state)["Render"](alpha);
+
+      if (!result.valid())
+      {
+        sol::error err = result;
+        utility::LogError("Received Lua error on render: {}", err.what());
+      }
+    }
+    catch (const std::exception& err) {
+      utility::LogError("A scripting error occurred!\nProject: {}\nError: {}", project_path.string(), err.what());
+    }
+  }
+
   void OnQuit()
   {
     try {
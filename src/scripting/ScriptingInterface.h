@@ -62,10 +62,21 @@ namespace term_engine::scripting {
   /**
    * @brief Runs the "Loop" Lua function, which is used to execute game code every frame.
    * 
-   * @param[in] timestep The timestep for this frame, i.e. the amount of time in milliseconds (ms) since the last frame ticked.
+   * @details The timestep is passed to Lua in the unit set with _system::SetTimestepUnit_, which is milliseconds (ms) by default.
+   * 
+   * @param[in] timestep The timestep for this frame, i.e. the amount of time in nanoseconds (ns) since the last frame ticked.
    */
   void OnLoop(uint64_t timestep);
 
+  /**
+   * @brief Runs the "Render" Lua function, which is used to position what is drawn each frame, even on frames where no tick ran.
+   * 
+   * @details With a fixed timestep, the alpha can be used to interpolate objects between their previous and current positions.
+   * 
+   * @param[in] alpha How far the program is between the last tick and the next one, from 0 to 1. This is always 1 if the simulation runs once per frame.
+   */
+  void OnRender(double alpha);
+
   /**
    * @brief Runs the "Quit" Lua function, which runs game code before closing TermEngine.
    * 
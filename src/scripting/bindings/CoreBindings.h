@@ -21,6 +21,7 @@ namespace term_engine::scripting::bindings {
       return true;
     };
     state["Loop"] = [&](uint64_t) -> void {};
+    state["Render"] = [&](double) -> void {};
     state["Quit"] = [&]() -> void {
       utility::LogInfo("TermEngine is quitting!");
     };
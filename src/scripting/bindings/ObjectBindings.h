@@ -13,8 +13,10 @@
 #include "../../usertypes/GameWindow.h"
 #include "../../usertypes/Timer.h"
 #include "../../usertypes/Window.h"
+#include "../../usertypes/WorldMap.h"
 #include "../../usertypes/game_objects/BaseObject.h"
 #include "../../usertypes/game_objects/GameObject.h"
+#include "../../usertypes/game_objects/TagIndex.h"
 #include "../../usertypes/game_objects/TimedFunction.h"
 #include "../../usertypes/resources/BaseResource.h"
 #include "../../usertypes/resources/Animation.h"
@@ -41,6 +43,33 @@ SOL_DERIVED_CLASSES(term_engine::usertypes::BaseObject, term_engine::usertypes::
 SOL_DERIVED_CLASSES(term_engine::usertypes::BaseResource, term_engine::usertypes::Animation, term_engine::usertypes::Audio, term_engine::usertypes::Font, term_engine::usertypes::Image, term_engine::usertypes::ShaderProgram);
 
 namespace term_engine::scripting::bindings {
+  /**
+   * @brief Forwards a call from Lua to a method of the game object that a reference refers to.
+   * @details A Lua error is raised if the object has been released, so that a script holding onto it can't reach whichever object reuses it from the pool.
+   */
+  template<auto Method>
+  struct GameObjectMethod;
+
+  template<typename Class, typename Result, typename... Args, Result (Class::*Method)(Args...)>
+  struct GameObjectMethod<Method> {
+    static Result Call(const usertypes::GameObjectRef& ref, Args... args)
+    {
+      return (ref.GetChecked().*Method)(std::forward<Args>(args)...);
+    }
+  };
+
+  template<typename Class, typename Result, typename... Args, Result (Class::*Method)(Args...) const>
+  struct GameObjectMethod<Method> {
+    static Result Call(const usertypes::GameObjectRef& ref, Args... args)
+    {
+      return (ref.GetChecked().*Method)(std::forward<Args>(args)...);
+    }
+  };
+
+  /// @brief The function that forwards a call from Lua to the given method of a game object.
+  template<auto Method>
+  constexpr auto ForwardToGameObject = &GameObjectMethod<Method>::Call;
+
   /**
    * @brief Binds the usertype classes to the Lua state.
    * 
@@ -59,7 +88,7 @@ namespace term_engine::scripting::bindings {
       sol::meta_function::construct, sol::no_constructor,
       sol::base_classes, sol::bases<usertypes::Flaggable>(),
       "id", sol::readonly_property(&usertypes::BaseObject::GetObjectId),
-      "type", sol::readonly_property(&usertypes::BaseObject::GetObjectType),
+      "type", sol::readonly_property(&usertypes::BaseObject::GetObjectTypeName),
       "active", sol::property(&usertypes::BaseObject::IsActive, &usertypes::BaseObject::SetActive));
 
     state.new_usertype<usertypes::BaseResource>(
@@ -69,21 +98,49 @@ namespace term_engine::scripting::bindings {
       "type", sol::readonly_property(&usertypes::BaseResource::GetResourceType),
       "name", sol::readonly_property(&usertypes::BaseResource::GetName));
 
-    state.new_usertype<usertypes::GameObject>(
+    // Game objects are handed to Lua as references, which stop working once the object is released.
+    const auto add_game_object = sol::factories(
+      [](const glm::ivec2& position, const glm::ivec2& size, usertypes::GameSceneVariant game_scene) { return usertypes::MakeGameObjectRef(usertypes::AddGameObjectToScene(position, size, game_scene)); },
+      [](const glm::ivec2& position, const glm::ivec2& size) { return usertypes::MakeGameObjectRef(usertypes::AddGameObject(position, size)); });
+    const auto next_game_object = [](usertypes::GameObjectQuery& query) { return usertypes::MakeGameObjectRef(query.Next()); };
+
+    state.new_usertype<usertypes::GameObjectRef>(
       "GameObject",
-      sol::meta_function::construct, sol::factories(&usertypes::AddGameObjectToScene, &usertypes::AddGameObject),
-      sol::call_constructor, sol::factories(&usertypes::AddGameObjectToScene, &usertypes::AddGameObject),
-      sol::base_classes, sol::bases<usertypes::BaseObject, usertypes::Flaggable>(),
+      sol::meta_function::construct, add_game_object,
+      sol::call_constructor, add_game_object,
       sol::meta_function::type, state.create_table_with("name", "GameObject"),
-      "layer", sol::property(&usertypes::GameObject::GetLayer, &usertypes::GameObject::SetLayer),
-      "hovering", sol::readonly_property(&usertypes::GameObject::IsHoveringOver),
-      "position", sol::property(&usertypes::GameObject::GetPosition, &usertypes::GameObject::SetPosition),
-      "characterMap", sol::property(&usertypes::GameObject::GetCharacterMap, &usertypes::GameObject::SetCharacterMap),
-      "animation", sol::readonly_property(&usertypes::GameObject::GetAnimation),
-      "set", &usertypes::GameObject::Set,
-      "gameScene", sol::readonly_property(&usertypes::GameObject::GetGameScene),
-      "moveToScene", &usertypes::GameObject::MoveToGameScene,
-      "copyToScene", &usertypes::GameObject::CopyToGameScene);
+      "id", sol::readonly_property(&usertypes::GameObjectRef::GetObjectId),
+      "type", sol::readonly_property(ForwardToGameObject<&usertypes::BaseObject::GetObjectTypeName>),
+      "active", sol::property(ForwardToGameObject<&usertypes::BaseObject::IsActive>, ForwardToGameObject<&usertypes::BaseObject::SetActive>),
+      "release", [](const usertypes::GameObjectRef& ref) { if (usertypes::GameObject* game_object = ref.Get()) game_object->FlagForRemoval(); },
+      "preventRelease", ForwardToGameObject<&usertypes::Flaggable::UnflagForRemoval>,
+      "layer", sol::property(ForwardToGameObject<&usertypes::GameObject::GetLayer>, ForwardToGameObject<&usertypes::GameObject::SetLayer>),
+      "hovering", sol::readonly_property(ForwardToGameObject<&usertypes::GameObject::IsHoveringOver>),
+      "culled", sol::readonly_property(ForwardToGameObject<&usertypes::GameObject::IsCulled>),
+      "position", sol::property(ForwardToGameObject<&usertypes::GameObject::GetPosition>, ForwardToGameObject<&usertypes::GameObject::SetPosition>),
+      "characterMap", sol::property(ForwardToGameObject<&usertypes::GameObject::GetCharacterMap>, ForwardToGameObject<&usertypes::GameObject::SetCharacterMap>),
+      "animation", sol::readonly_property(ForwardToGameObject<&usertypes::GameObject::GetAnimation>),
+      "set", ForwardToGameObject<&usertypes::GameObject::Set>,
+      "gameScene", sol::readonly_property(ForwardToGameObject<&usertypes::GameObject::GetGameScene>),
+      "moveToScene", ForwardToGameObject<&usertypes::GameObject::MoveToGameScene>,
+      "copyToScene", [](const usertypes::GameObjectRef& ref, const std::string& name) { return usertypes::MakeGameObjectRef(ref.GetChecked().CopyToGameScene(name)); },
+      "collision", sol::property(ForwardToGameObject<&usertypes::GameObject::GetCollisionMode>, ForwardToGameObject<&usertypes::GameObject::SetCollisionMode>),
+      "tags", sol::readonly_property(ForwardToGameObject<&usertypes::GameObject::GetTagNames>),
+      "hasTag", ForwardToGameObject<&usertypes::GameObject::HasTag>,
+      "addTag", ForwardToGameObject<&usertypes::GameObject::AddTag>,
+      "removeTag", ForwardToGameObject<&usertypes::GameObject::RemoveTag>,
+      "getComponent", ForwardToGameObject<&usertypes::GameObject::GetComponent>,
+      "setComponent", ForwardToGameObject<&usertypes::GameObject::SetComponent>,
+      "removeComponent", ForwardToGameObject<&usertypes::GameObject::RemoveTag>,
+      "spawnMany", [](const usertypes::GameObjectRef& ref, const sol::table& positions) { return usertypes::MakeGameObjectRefs(usertypes::SpawnGameObjects(&ref.GetChecked(), positions)); },
+      "reserve", &usertypes::ReserveGameObjects,
+      "query", &usertypes::QueryGameObjects);
+
+    state.new_usertype<usertypes::GameObjectQuery>(
+      "GameObjectQuery",
+      sol::meta_function::construct, sol::no_constructor,
+      sol::meta_function::call, next_game_object,
+      "next", next_game_object);
 
     state.new_usertype<usertypes::TimedFunction>(
       "TimedFunction",
@@ -229,9 +286,12 @@ namespace term_engine::scripting::bindings {
                                                void(const glm::ivec2&, const sol::table&)>(),
       sol::meta_function::type, state.create_table_with("name", "CharacterMap"),
       "set", &usertypes::CharacterMap::SetFunction,
+      "get", &usertypes::CharacterMap::GetCharacter,
+      "setCharacter", &usertypes::CharacterMap::SetCharacter,
       "data", sol::property(&usertypes::CharacterMap::GetData, &usertypes::CharacterMap::SetData),
       "size", sol::property(&usertypes::CharacterMap::GetSize, &usertypes::CharacterMap::SetSize),
-      "hideEmptyCharacters", sol::property(&usertypes::CharacterMap::AreEmptyCharactersHidden, &usertypes::CharacterMap::SetHideEmptyCharacters));
+      "hideEmptyCharacters", sol::property(&usertypes::CharacterMap::AreEmptyCharactersHidden, &usertypes::CharacterMap::SetHideEmptyCharacters),
+      "depthTest", sol::property(&usertypes::CharacterMap::IsDepthTested, &usertypes::CharacterMap::SetDepthTest));
 
     state.new_usertype<usertypes::EventListener>(
       "EventListener",
@@ -254,6 +314,13 @@ namespace term_engine::scripting::bindings {
       "name", sol::readonly_property(&usertypes::GameScene::GetName),
       "characterMap", sol::readonly_property(&usertypes::GameScene::GetCharacterMap),
       "gameWindow", sol::property(&usertypes::GameScene::GetGameWindow, &usertypes::GameScene::SetGameWindow),
+      "occlusionCulling", sol::property(&usertypes::GameScene::IsOcclusionCulled, &usertypes::GameScene::SetOcclusionCulling),
+      "worldMap", sol::readonly_property(&usertypes::GameScene::GetWorldMap),
+      "createWorldMap", &usertypes::GameScene::CreateWorldMap,
+      "streamWorldMap", &usertypes::GameScene::StreamWorldMap,
+      "removeWorldMap", &usertypes::GameScene::RemoveWorldMap,
+      "objectsAt", [](usertypes::GameScene& game_scene, const glm::ivec2& rowcol) { return usertypes::MakeGameObjectRefs(game_scene.GetObjectsAt(rowcol)); },
+      "objectsInRect", [](usertypes::GameScene& game_scene, const glm::ivec2& position, const glm::ivec2& size) { return usertypes::MakeGameObjectRefs(game_scene.GetObjectsInRect(position, size)); },
       "onInit", sol::property(&usertypes::GameScene::GetOnInit, &usertypes::GameScene::SetOnInit),
       "onLoop", sol::property(&usertypes::GameScene::GetOnLoop, &usertypes::GameScene::SetOnLoop),
       "onQuit", sol::property(&usertypes::GameScene::GetOnQuit, &usertypes::GameScene::SetOnQuit));
@@ -278,17 +345,21 @@ namespace term_engine::scripting::bindings {
     
     state.new_usertype<usertypes::Timer>(
       "Timer",
-      sol::meta_function::construct, sol::constructors<void()>(),
-      sol::call_constructor, sol::constructors<void()>(),
+      sol::meta_function::construct, sol::factories([]() { return usertypes::Timer(true); }),
+      sol::call_constructor, sol::factories([]() { return usertypes::Timer(true); }),
       sol::meta_function::type, state.create_table_with("name", "Timer"),
       "start", &usertypes::Timer::Start,
       "stop", &usertypes::Timer::Stop,
       "pause", &usertypes::Timer::Pause,
       "resume", &usertypes::Timer::Resume,
       "interval", &usertypes::Timer::GetIntervalElapsed,
+      "intervalNs", &usertypes::Timer::GetIntervalElapsedNs,
+      "intervalSeconds", &usertypes::Timer::GetIntervalElapsedSeconds,
       "started", sol::readonly_property(&usertypes::Timer::IsStarted),
       "paused", sol::readonly_property(&usertypes::Timer::IsPaused),
       "duration", sol::readonly_property(&usertypes::Timer::GetDuration),
+      "durationNs", sol::readonly_property(&usertypes::Timer::GetDurationNs),
+      "durationSeconds", sol::readonly_property(&usertypes::Timer::GetDurationSeconds),
       "pausedDuration", sol::readonly_property(&usertypes::Timer::GetPauseDuration));
 
     state.new_usertype<usertypes::Window>(
@@ -309,6 +380,24 @@ namespace term_engine::scripting::bindings {
       "captured", sol::property(&usertypes::Window::IsMouseGrabbed, &usertypes::Window::SetMouseGrab),
       "clearColour", sol::property(&usertypes::Window::GetClearColour, &usertypes::Window::SetClearColour),
       "renderMode", sol::property(&usertypes::Window::IsWireframeEnabled, &usertypes::Window::SetWireframe));
+
+    state.new_usertype<usertypes::WorldMap>(
+      "WorldMap",
+      sol::meta_function::construct, sol::no_constructor,
+      sol::meta_function::type, state.create_table_with("name", "WorldMap"),
+      "size", sol::readonly_property(&usertypes::WorldMap::GetSize),
+      "camera", sol::property(&usertypes::WorldMap::GetCameraPosition, &usertypes::WorldMap::SetCameraPosition),
+      "cameraSize", sol::readonly_property(&usertypes::WorldMap::GetCameraSize),
+      "centerCamera", &usertypes::WorldMap::CenterCamera,
+      "chunkCount", sol::readonly_property(&usertypes::WorldMap::GetChunkCount),
+      "streamed", sol::readonly_property(&usertypes::WorldMap::IsStreamed),
+      "memoryBudget", sol::property(&usertypes::WorldMap::GetMemoryBudget, &usertypes::WorldMap::SetMemoryBudget),
+      "get", &usertypes::WorldMap::GetCharacter,
+      "set", &usertypes::WorldMap::SetCharacter,
+      "fill", &usertypes::WorldMap::Fill,
+      "push", &usertypes::WorldMap::PushCharacters,
+      "clear", &usertypes::WorldMap::Clear,
+      "save", &usertypes::WorldMap::Save);
   }
 }
 
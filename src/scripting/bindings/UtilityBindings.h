@@ -7,6 +7,7 @@
 #include "../../events/InputManager.h"
 #include "../../system/FileFunctions.h"
 #include "../../system/FPSManager.h"
+#include "../../system/Profiler.h"
 #include "../../usertypes/Character.h"
 #include "../../usertypes/EventListener.h"
 #include "../../usertypes/GameScene.h"
@@ -47,13 +48,31 @@ namespace term_engine::scripting::bindings {
       "HIDE", 0,
       "CLOSE", 1,
       "QUIT", 2);
+
+    state.create_named_table("collisionMode",
+      "NONE", 0,
+      "RECT", 1,
+      "CELL", 2);
     
+    state.create_named_table("timestepUnit",
+      "MILLISECONDS", 0,
+      "SECONDS", 1);
+
     state.create_named_table("fps",
       "print", &system::PrintFPS,
       "getAverage", &system::GetAverageFPS,
       "usingTarget", &system::IsUsingTargetFPS,
       "target", sol::overload(&system::GetTargetFPS, &system::SetTargetFPS),
-      "getFrames", &system::GetFrameCount);
+      "getFrames", &system::GetFrameCount,
+      "usingFixedTimestep", &system::IsUsingFixedTimestep,
+      "tickRate", sol::overload(&system::GetTickRate, &system::SetTickRate),
+      "getAlpha", &system::GetInterpolationAlpha,
+      "getFrameTime", &system::GetFrameTimePercentile,
+      "getP50", &system::GetFrameTimeP50,
+      "getP99", &system::GetFrameTimeP99,
+      "idle", sol::overload(&system::IsIdleModeEnabled, &system::SetIdleMode),
+      "redraw", &system::RequestRedraw,
+      "timestepUnit", sol::overload(&system::GetTimestepUnit, &system::SetTimestepUnit));
 
     state.create_named_table("filesystem",
       "read", &system::ReadFile,
@@ -77,6 +96,9 @@ namespace term_engine::scripting::bindings {
       "getPosition", &events::GetMousePosition,
       "getMovement", &events::GetMouseMovement);
 
+    state.create_named_table("profiler",
+      "last", &system::GetLastProfile);
+
     state.create_named_table("project",
       "load", &SetNextProject,
       "reload", &ReloadProject);
@@ -99,20 +121,20 @@ namespace term_engine::scripting::bindings {
     state.set_function("getRowColFromIndex", sol::overload(
       sol::resolve<glm::ivec2(const glm::ivec2&, uint32_t)>(&utility::GetRowColFromIndex),
       sol::resolve<glm::ivec2(usertypes::CharacterMap*, uint32_t)>(&utility::GetRowColFromIndex),
-      sol::resolve<glm::ivec2(usertypes::GameObject*, uint32_t)>(&utility::GetRowColFromIndex),
+      [](const usertypes::GameObjectRef& ref, uint32_t index) { return utility::GetRowColFromIndex(&ref.GetChecked(), index); },
       sol::resolve<glm::ivec2(usertypes::AnimationFrame*, uint32_t)>(&utility::GetRowColFromIndex),
       sol::resolve<glm::ivec2(usertypes::GameScene*, uint32_t)>(&utility::GetRowColFromIndex),
       sol::resolve<glm::ivec2(usertypes::GameWindow*, uint32_t)>(&utility::GetRowColFromIndex)));
     state.set_function("getIndexFromRowCol", sol::overload(
       sol::resolve<uint32_t(const glm::ivec2&, const glm::ivec2&)>(&utility::GetIndexFromRowCol),
       sol::resolve<uint32_t(usertypes::CharacterMap*, const glm::ivec2&)>(&utility::GetIndexFromRowCol),
-      sol::resolve<uint32_t(usertypes::GameObject*, const glm::ivec2&)>(&utility::GetIndexFromRowCol),
+      [](const usertypes::GameObjectRef& ref, const glm::ivec2& rowcol) { return utility::GetIndexFromRowCol(&ref.GetChecked(), rowcol); },
       sol::resolve<uint32_t(usertypes::AnimationFrame*, const glm::ivec2&)>(&utility::GetIndexFromRowCol),
       sol::resolve<uint32_t(usertypes::GameScene*, const glm::ivec2&)>(&utility::GetIndexFromRowCol),
       sol::resolve<uint32_t(usertypes::GameWindow*, const glm::ivec2&)>(&utility::GetIndexFromRowCol)));
 
     state.set_function("getEventListenerById", &usertypes::GetEventListenerById);
-    state.set_function("getGameObjectById", &usertypes::GetGameObjectById);
+    state.set_function("getGameObjectById", [](uint64_t id) { return usertypes::MakeGameObjectRef(usertypes::GetGameObjectById(id)); });
     state.set_function("getTimedFunctionById", &usertypes::GetTimedFunctionById);
     state.set_function("getGameSceneByName", &usertypes::GetGameSceneByName);
   }
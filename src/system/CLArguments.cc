@@ -9,7 +9,14 @@ namespace term_engine::system {
     cxxopts::Options options("TermEngine", "Game engine that focuses on creating text-based games.");
     options.add_options()
       ("project", "The project to execute.", cxxopts::value<std::string>()->default_value(""))
-      ("debug", "Enable debugging options?", cxxopts::value<bool>());
+      ("debug", "Enable debugging options?", cxxopts::value<bool>())
+      ("no-render-thread", "Draw frames on the main thread, instead of a separate render thread?", cxxopts::value<bool>())
+      ("profile", "Write the frame profiler's timings to a CSV file on exit.", cxxopts::value<std::string>()->default_value(""))
+      ("trace", "Record a trace of each frame to a file, in Chrome's trace event format.", cxxopts::value<std::string>()->default_value(""))
+      ("headless", "Run without a display or sound device, e.g. when replaying input on a build server?", cxxopts::value<bool>())
+      ("record", "Record the input and timestep of each frame to a file.", cxxopts::value<std::string>()->default_value(""))
+      ("replay", "Replay a recording of input as fast as possible, and report the frame rate.", cxxopts::value<std::string>()->default_value(""))
+      ("replay-report", "Write how quickly the recording was replayed to a JSON file.", cxxopts::value<std::string>()->default_value(""));
     options.parse_positional({ "project" });
 
     try
@@ -18,6 +25,13 @@ namespace term_engine::system {
 
       scriptPath = std::filesystem::path(result["project"].as<std::string>());
       debug_mode = result["debug"].as<bool>();
+      use_render_thread = !result["no-render-thread"].as<bool>();
+      profile_path = std::filesystem::path(result["profile"].as<std::string>());
+      trace_path = std::filesystem::path(result["trace"].as<std::string>());
+      headless_mode = result["headless"].as<bool>();
+      record_path = std::filesystem::path(result["record"].as<std::string>());
+      replay_path = std::filesystem::path(result["replay"].as<std::string>());
+      replay_report_path = std::filesystem::path(result["replay-report"].as<std::string>());
     }
     catch (cxxopts::exceptions::parsing& ex)
     {
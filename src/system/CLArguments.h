@@ -9,13 +9,27 @@ namespace term_engine::system {
   /**
    * @details The command-line arguments are laid out as follows:
    * 
-   * TermEngine.exe [scriptPath]
+   * TermEngine.exe [scriptPath] [--debug] [--no-render-thread] [--profile file] [--trace file] [--headless] [--record file] [--replay file] [--replay-report file]
    */
 
   /// @brief The path to the script to execute from the command line.
   inline std::filesystem::path scriptPath;
   /// @brief Define if the "--debug" flag been enabled, making the debug window available.
   inline bool debug_mode = false;
+  /// @brief Should frames be drawn on a separate render thread? This is disabled with the "--no-render-thread" flag, and is always disabled on macOS.
+  inline bool use_render_thread = true;
+  /// @brief The path to write the frame profiler's timings to on exit, if set with the "--profile" flag.
+  inline std::filesystem::path profile_path;
+  /// @brief The path to write a Chrome trace of the engine's zones and Lua callbacks to, if set with the "--trace" flag.
+  inline std::filesystem::path trace_path;
+  /// @brief Should the program run without a display or sound device? This is enabled with the "--headless" flag.
+  inline bool headless_mode = false;
+  /// @brief The path to record the input and timestep of each frame to, if set with the "--record" flag.
+  inline std::filesystem::path record_path;
+  /// @brief The path to replay a recording of input from, if set with the "--replay" flag.
+  inline std::filesystem::path replay_path;
+  /// @brief The path to write how quickly a recording was replayed to, if set with the "--replay-report" flag.
+  inline std::filesystem::path replay_report_path;
 
   /**
    * @brief Gets the command-line arguments passed to the program.
@@ -1,12 +1,20 @@
+#include <algorithm>
 #include <chrono>
 #include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
 #include "FPSManager.h"
 #include "../utility/LogUtils.h"
+#include "../utility/SDLUtils.h"
 
 namespace term_engine::system {
   void InitFPS()
   {
-    delay_timer_.Start();
+    frame_deadline_ = usertypes::Clock::now();
+    last_frame_point_ = frame_deadline_;
     average_timer_.Start();
 
     utility::LogDebug("Started FPS.");
@@ -14,22 +22,65 @@ namespace term_engine::system {
 
   uint64_t Delay()
   {
-    uint64_t time_taken = delay_timer_.GetDuration();
-    int64_t remaining = frame_duration_ - time_taken;
-    
-    if (remaining > 0) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(remaining));
+    usertypes::TimePoint now = usertypes::Clock::now();
+    const uint64_t time_taken = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_frame_point_).count();
+
+    if (frame_duration_ > 0) {
+      frame_deadline_ += std::chrono::nanoseconds(frame_duration_);
+
+      // If the frame overran by more than a whole frame, start the deadlines again from now instead of rushing through frames to catch up.
+      if (now - frame_deadline_ > std::chrono::nanoseconds(frame_duration_)) {
+        frame_deadline_ = now;
+      }
+      else if (now < frame_deadline_) {
+        WaitUntil(frame_deadline_);
+        now = usertypes::Clock::now();
+      }
+    }
+    else {
+      frame_deadline_ = now;
     }
 
-    delay_timer_.Start();
+    RecordFrameTime(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_frame_point_).count());
+    last_frame_point_ = now;
 
     return time_taken;
   }
 
+  void WaitUntil(const usertypes::TimePoint& deadline)
+  {
+    const usertypes::TimePoint sleep_deadline = deadline - std::chrono::nanoseconds(FRAME_SPIN_THRESHOLD);
+
+    if (usertypes::Clock::now() < sleep_deadline) {
+#if defined(__linux__)
+      // The steady clock is based on CLOCK_MONOTONIC, so its time can be passed as an absolute time to sleep until.
+      const uint64_t sleep_time = std::chrono::duration_cast<std::chrono::nanoseconds>(sleep_deadline.time_since_epoch()).count();
+      timespec sleep_spec;
+      sleep_spec.tv_sec = sleep_time / 1000000000;
+      sleep_spec.tv_nsec = sleep_time % 1000000000;
+
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sleep_spec, nullptr) == EINTR) {}
+#else
+      std::this_thread::sleep_until(sleep_deadline);
+#endif
+    }
+
+    while (usertypes::Clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+  }
+
+  void RecordFrameTime(uint64_t frame_time)
+  {
+    frame_times_[frame_time_index_] = frame_time;
+    frame_time_index_ = (frame_time_index_ + 1) % FRAME_TIME_SAMPLES;
+    frame_time_count_ = std::min(frame_time_count_ + 1, FRAME_TIME_SAMPLES);
+  }
+
   void CalculateFPS()
   {
     if (frame_count_ % FPS_FRAME_MULTIPLE == 0 && frame_count_ > 0) {
-      float time_taken = (float)average_timer_.GetIntervalElapsed() / 1000.0f;
+      float time_taken = (float)average_timer_.GetIntervalElapsedSeconds();
       average_fps_ = (float)FPS_FRAME_MULTIPLE / time_taken;
     }
   }
@@ -63,12 +114,166 @@ namespace term_engine::system {
   {
     if (target > 0) {
       target_fps_ = target;
-      frame_duration_ = 1000.0f / target_fps_;
+      frame_duration_ = 1000000000 / target_fps_;
     }
     else {
       target_fps_ = 0;
       frame_duration_ = 0;
     }
+
+    frame_deadline_ = usertypes::Clock::now();
+  }
+
+  double GetFrameTimePercentile(double percentile)
+  {
+    static std::vector<uint64_t> sorted_times;
+
+    if (frame_time_count_ == 0) {
+      return 0.0;
+    }
+
+    sorted_times.assign(frame_times_.begin(), frame_times_.begin() + frame_time_count_);
+
+    const size_t rank = (size_t)(std::clamp(percentile, 0.0, 100.0) / 100.0 * (double)(frame_time_count_ - 1) + 0.5);
+    std::nth_element(sorted_times.begin(), sorted_times.begin() + rank, sorted_times.end());
+
+    return (double)sorted_times[rank] / (double)usertypes::NANOSECONDS_PER_MILLISECOND;
+  }
+
+  double GetFrameTimeP50()
+  {
+    return GetFrameTimePercentile(50.0);
+  }
+
+  double GetFrameTimeP99()
+  {
+    return GetFrameTimePercentile(99.0);
+  }
+
+  bool IsUsingFixedTimestep()
+  {
+    return tick_rate_ > 0;
+  }
+
+  uint32_t GetTickRate()
+  {
+    return tick_rate_;
+  }
+
+  void SetTickRate(uint32_t rate)
+  {
+    if (rate > 0) {
+      tick_rate_ = rate;
+      tick_duration_ = 1000000000 / tick_rate_;
+    }
+    else {
+      tick_rate_ = 0;
+      tick_duration_ = 0;
+    }
+
+    tick_accumulator_ = 0;
+  }
+
+  uint64_t GetTickDuration()
+  {
+    return tick_duration_;
+  }
+
+  uint32_t AccumulateTicks(uint64_t timestep)
+  {
+    if (tick_duration_ == 0) {
+      return 0;
+    }
+
+    tick_accumulator_ += timestep;
+
+    uint64_t ticks = tick_accumulator_ / tick_duration_;
+
+    if (ticks > MAX_TICKS_PER_FRAME) {
+      ticks = MAX_TICKS_PER_FRAME;
+      tick_accumulator_ %= tick_duration_;
+    }
+    else {
+      tick_accumulator_ -= ticks * tick_duration_;
+    }
+
+    return (uint32_t)ticks;
+  }
+
+  double GetInterpolationAlpha()
+  {
+    if (tick_duration_ == 0) {
+      return 1.0;
+    }
+
+    return (double)tick_accumulator_ / (double)tick_duration_;
+  }
+
+  TimestepUnit GetTimestepUnit()
+  {
+    return timestep_unit_;
+  }
+
+  void SetTimestepUnit(TimestepUnit unit)
+  {
+    timestep_unit_ = unit;
+  }
+
+  double ConvertTimestep(uint64_t timestep)
+  {
+    if (timestep_unit_ == TimestepUnit::SECONDS) {
+      return (double)timestep / usertypes::NANOSECONDS_PER_SECOND;
+    }
+
+    return (double)timestep / (double)usertypes::NANOSECONDS_PER_MILLISECOND;
+  }
+
+  bool IsIdleModeEnabled()
+  {
+    return idle_mode_;
+  }
+
+  void SetIdleMode(bool flag)
+  {
+    idle_mode_ = flag;
+    redraw_requested_ = true;
+  }
+
+  void RequestRedraw()
+  {
+    redraw_requested_ = true;
+  }
+
+  bool TakeRedrawRequest()
+  {
+    const bool requested = redraw_requested_;
+    redraw_requested_ = false;
+
+    return requested;
+  }
+
+  uint64_t GetIdleWaitMs(uint64_t timeout)
+  {
+    if (timeout >= (uint64_t)MAX_IDLE_WAIT * usertypes::NANOSECONDS_PER_MILLISECOND) {
+      return MAX_IDLE_WAIT;
+    }
+
+    return (timeout + usertypes::NANOSECONDS_PER_MILLISECOND - 1) / usertypes::NANOSECONDS_PER_MILLISECOND;
+  }
+
+  void WaitForEvents(uint64_t timeout)
+  {
+    const uint64_t timeout_ms = GetIdleWaitMs(timeout);
+
+    if (timeout_ms == 0) {
+      return;
+    }
+
+    // Passing a null event leaves the event in the queue, so that it is handled by the main loop as normal.
+    SDL_WaitEventTimeout(nullptr, (int)timeout_ms);
+
+    frame_deadline_ = usertypes::Clock::now();
+    last_frame_point_ = frame_deadline_;
   }
 
   void PrintFPS()
@@ -77,7 +282,12 @@ namespace term_engine::system {
       utility::LogInfo("Target FPS: {}", target_fps_);
     }
     
+    if (tick_rate_ > 0) {
+      utility::LogInfo("Tick rate: {}", tick_rate_);
+    }
+
     utility::LogInfo("Average FPS: {}", GetAverageFPS());
     utility::LogInfo("Frame count: {}", frame_count_);
+    utility::LogInfo("Frame time (p50/p99): {:.3f}ms/{:.3f}ms", GetFrameTimeP50(), GetFrameTimeP99());
   }
 }
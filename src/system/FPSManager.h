@@ -3,6 +3,9 @@
 #ifndef FPS_MANAGER_H
 #define FPS_MANAGER_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include "../usertypes/Timer.h"
 
 namespace term_engine::system {
@@ -10,9 +13,28 @@ namespace term_engine::system {
   constexpr uint32_t FPS_FRAME_MULTIPLE = 5;
   /// @brief Represents the default FPS when starting the program.
   constexpr uint32_t DEFAULT_FPS = 60;
+  /// @brief How long before the end of a frame to stop sleeping and start spinning, in nanoseconds (ns). This covers the time the OS may take to wake the program up.
+  constexpr uint64_t FRAME_SPIN_THRESHOLD = 1000000;
+  /// @brief The most simulation ticks that can run in a single frame. If the program falls further behind than this, the extra time is dropped rather than simulated.
+  constexpr uint32_t MAX_TICKS_PER_FRAME = 5;
+  /// @brief The number of recent frame times kept for calculating frame time percentiles.
+  constexpr size_t FRAME_TIME_SAMPLES = 256;
+  /// @brief The longest time to block for while idle, in milliseconds (ms). This lets the frame rate counters and anything that isn't driven by events catch up now and then.
+  constexpr uint32_t MAX_IDLE_WAIT = 1000;
 
-  /// @brief The timer used to delay the program for the rest of the current frame.
-  inline usertypes::Timer delay_timer_;
+  /// @brief Defines the unit of time that timesteps are passed to Lua in.
+  enum TimestepUnit { MILLISECONDS = 0, SECONDS = 1 };
+
+  /// @brief The point in time that the current frame should end at, if a target frame rate is set.
+  inline usertypes::TimePoint frame_deadline_;
+  /// @brief The point in time that the last frame ended at.
+  inline usertypes::TimePoint last_frame_point_;
+  /// @brief The most recent frame times, in nanoseconds (ns). This is used as a ring buffer.
+  inline std::array<uint64_t, FRAME_TIME_SAMPLES> frame_times_;
+  /// @brief The number of frame times that have been recorded, up to _FRAME_TIME_SAMPLES_.
+  inline size_t frame_time_count_ = 0;
+  /// @brief The index in _frame_times_ that the next frame time is recorded to.
+  inline size_t frame_time_index_ = 0;
   /// @brief The timer used to calculate the average frame rate.
   inline usertypes::Timer average_timer_;
   /// @brief The average frame rate while running the program.
@@ -21,15 +43,47 @@ namespace term_engine::system {
   inline uint32_t target_fps_ = 0;
   /// @brief The number of frames that have run since the program was started.
   inline uint64_t frame_count_ = 0;
-  /// @brief If a target frame rate is set, this is the amount of time between frames. E.g. A target of 10FPS means that _frame_duration_ is 0.1, or 100ms.
+  /// @brief If a target frame rate is set, this is the amount of time between frames, in nanoseconds (ns). E.g. A target of 10FPS means that _frame_duration_ is 0.1s, or 100,000,000ns.
   inline uint64_t frame_duration_ = 0;
+  /// @brief The rate that the simulation ticks at, if it is running at a fixed timestep. If this is 0, the simulation runs once per frame instead.
+  inline uint32_t tick_rate_ = 0;
+  /// @brief If a tick rate is set, this is the amount of time each tick simulates, in nanoseconds (ns).
+  inline uint64_t tick_duration_ = 0;
+  /// @brief The amount of time that has passed, but not yet been simulated, in nanoseconds (ns).
+  inline uint64_t tick_accumulator_ = 0;
+  /// @brief The unit of time that timesteps are passed to Lua in. Defaults to milliseconds (ms), which older projects expect.
+  inline TimestepUnit timestep_unit_ = TimestepUnit::MILLISECONDS;
+  /// @brief Should the program block until something happens, instead of running frames when there's nothing to update?
+  inline bool idle_mode_ = false;
+  /// @brief Has a frame been requested, which stops the program from idling before the next frame?
+  inline bool redraw_requested_ = false;
 
   /// @brief Prepares the timers ready for calculating/capping the frame rate.
   void InitFPS();
 
-  /// @brief Tells the program to wait until the next frame starts (if a target framerate is set).
+  /**
+   * @brief Tells the program to wait until the next frame starts (if a target framerate is set), and records the frame time.
+   * @details Each frame is given an absolute deadline that follows on from the last one, so that time spent waking up isn't added onto the next frame.
+   *          The program sleeps until shortly before the deadline, and then spins for the remaining time, as sleeping can overshoot by a whole scheduler tick.
+   * 
+   * @returns The amount of time the frame took before waiting, in nanoseconds (ns).
+   */
   uint64_t Delay();
 
+  /**
+   * @brief Waits until the given point in time, sleeping for as much of it as can be done precisely.
+   * 
+   * @param[in] deadline The point in time to wait until.
+   */
+  void WaitUntil(const usertypes::TimePoint& deadline);
+
+  /**
+   * @brief Records how long the last frame took.
+   * 
+   * @param[in] frame_time The frame time, in nanoseconds (ns).
+   */
+  void RecordFrameTime(uint64_t frame_time);
+
   /// @brief Calculates the average frame rate.
   void CalculateFPS();
 
@@ -71,6 +125,137 @@ namespace term_engine::system {
    */
   void SetTargetFPS(uint32_t target);
 
+  /**
+   * @brief Is the simulation running at a fixed timestep?
+   * 
+   * @returns If the simulation is ticking at a fixed rate, separately from the frame rate.
+   */
+  bool IsUsingFixedTimestep();
+
+  /**
+   * @brief Retrieves the rate that the simulation ticks at.
+   * 
+   * @returns The tick rate, or 0 if the simulation runs once per frame.
+   */
+  uint32_t GetTickRate();
+
+  /**
+   * @brief Sets the rate that the simulation ticks at. Setting this to 0 will run the simulation once per frame, with a variable timestep.
+   * 
+   * @param[in] rate The tick rate to set.
+   */
+  void SetTickRate(uint32_t rate);
+
+  /**
+   * @brief Retrieves the amount of time each tick simulates.
+   * 
+   * @returns The tick duration, in nanoseconds (ns).
+   */
+  uint64_t GetTickDuration();
+
+  /**
+   * @brief Adds the time taken by the last frame to the time waiting to be simulated, and returns how many ticks to run to simulate it.
+   * @details Any time left over is carried into the next frame. If more than _MAX_TICKS_PER_FRAME_ ticks are due, the extra time is dropped so that the program can catch up.
+   * 
+   * @param[in] timestep The time since the last frame, in nanoseconds (ns).
+   * @returns The number of ticks to run.
+   */
+  uint32_t AccumulateTicks(uint64_t timestep);
+
+  /**
+   * @brief Retrieves how far the program is between the last tick and the next one, which is used to interpolate what is rendered.
+   * 
+   * @returns The interpolation alpha, from 0 to 1. This is always 1 if the simulation runs once per frame.
+   */
+  double GetInterpolationAlpha();
+
+  /**
+   * @brief Retrieves the unit of time that timesteps are passed to Lua in.
+   * 
+   * @returns The unit of time.
+   */
+  TimestepUnit GetTimestepUnit();
+
+  /**
+   * @brief Sets the unit of time that timesteps are passed to Lua in.
+   * 
+   * @param[in] unit The unit of time to use.
+   */
+  void SetTimestepUnit(TimestepUnit unit);
+
+  /**
+   * @brief Converts a timestep into the unit of time that is passed to Lua.
+   * @details The converted timestep keeps any fraction of the unit, so no time is lost to rounding at high frame rates.
+   * 
+   * @param[in] timestep The timestep, in nanoseconds (ns).
+   * @returns The timestep, in the current timestep unit.
+   */
+  double ConvertTimestep(uint64_t timestep);
+
+  /**
+   * @brief Returns if idle mode is enabled.
+   * 
+   * @returns If idle mode is enabled.
+   */
+  bool IsIdleModeEnabled();
+
+  /**
+   * @brief Sets if idle mode is enabled.
+   * @details While idle, the program blocks until an event arrives or a timed function is due, rather than running frames that change nothing. A frame is always run after enabling it, so that the windows are up to date.
+   * 
+   * @param[in] flag Flag to enable/disable idle mode.
+   */
+  void SetIdleMode(bool flag);
+
+  /// @brief Requests that the next frame runs without idling, e.g. after changing a character map outside of an event.
+  void RequestRedraw();
+
+  /**
+   * @brief Returns if a frame has been requested, and clears the request.
+   * 
+   * @returns If a frame has been requested.
+   */
+  bool TakeRedrawRequest();
+
+  /**
+   * @brief Blocks until an SDL event arrives, or the timeout passes.
+   * @details The frame pacer is restarted afterwards, so that the time spent idle isn't counted as a slow frame.
+   * 
+   * @param[in] timeout The longest time to block for, in nanoseconds (ns). This is rounded up to the next millisecond, and capped at _MAX_IDLE_WAIT_.
+   */
+  void WaitForEvents(uint64_t timeout);
+
+  /**
+   * @brief Converts a timeout into the number of milliseconds to block for when idle.
+   * @details The timeout is capped before it is rounded up, so that a timeout of _UINT64_MAX_ (i.e. there are no timers) can't overflow.
+   * 
+   * @param[in] timeout The longest time to block for, in nanoseconds (ns).
+   * @returns The time to block for, in milliseconds (ms), rounded up and capped at _MAX_IDLE_WAIT_.
+   */
+  uint64_t GetIdleWaitMs(uint64_t timeout);
+
+  /**
+   * @brief Retrieves the frame time that the given percentage of recent frames took at most.
+   * 
+   * @param[in] percentile The percentile to find, from 0 to 100.
+   * @returns The frame time, in milliseconds (ms), or 0 if no frames have been recorded.
+   */
+  double GetFrameTimePercentile(double percentile);
+
+  /**
+   * @brief Retrieves the median frame time of recent frames.
+   * 
+   * @returns The frame time, in milliseconds (ms).
+   */
+  double GetFrameTimeP50();
+
+  /**
+   * @brief Retrieves the frame time that 99% of recent frames took at most, which shows how large frame spikes are.
+   * 
+   * @returns The frame time, in milliseconds (ms).
+   */
+  double GetFrameTimeP99();
+
   /// @brief Logs the average and target frame rates.
   void PrintFPS();
 }
@@ -107,6 +107,11 @@ namespace term_engine::system {
     return "";
   }
 
+  std::filesystem::path GetProjectFilePath(const std::string& filename)
+  {
+    return scripting::project_path / filename;
+  }
+
   std::string ReadFile(const std::string& filename)
   {
     std::filesystem::path filepath = SearchForResourcePath(filename);
@@ -147,7 +152,7 @@ namespace term_engine::system {
       return;
     }
 
-    std::filesystem::path filepath = scripting::project_path / filename;
+    std::filesystem::path filepath = GetProjectFilePath(filename);
     std::ofstream file_stream;
     std::ios_base::openmode mode = append ? std::ios::app : std::ios::trunc;
 
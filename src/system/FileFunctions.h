@@ -29,6 +29,15 @@ namespace term_engine::system {
    */
   std::filesystem::path SearchForResourcePath(const std::string& filename);
 
+  /**
+   * @brief Returns the path to a file within the project folder.
+   * @details Files that the program writes to are kept within the project folder.
+   * 
+   * @param[in] filename The path to the file, relative to the project folder.
+   * @returns The absolute path to the file.
+   */
+  std::filesystem::path GetProjectFilePath(const std::string& filename);
+
   /**
    * @brief Reads and returns the contents of a file.
    * @details If the file isn't found anywhere, a blank string is returned.
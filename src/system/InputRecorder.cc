@@ -0,0 +1,455 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <string>
+#include "InputRecorder.h"
+#include "CLArguments.h"
+#include "Tracer.h"
+#include "../events/InputManager.h"
+#include "../scripting/ScriptingInterface.h"
+#include "../utility/LogUtils.h"
+
+namespace term_engine::system {
+  void InitInputRecorder()
+  {
+    if (!replay_path.empty())
+    {
+      if (!record_path.empty())
+      {
+        utility::LogWarn("Input can't be recorded and replayed at the same time, only replaying \"{}\".", replay_path.string());
+      }
+
+      recording_file_.open(replay_path, std::ios::in | std::ios::binary);
+
+      if (!recording_file_.is_open())
+      {
+        utility::LogError("Failed to open input recording \"{}\".", replay_path.string());
+
+        return;
+      }
+
+      std::filesystem::path project_path;
+
+      if (!ReadRecordingHeader(project_path))
+      {
+        recording_file_.close();
+
+        return;
+      }
+
+      // Run the project that was recorded, unless a different one was asked for.
+      if (scriptPath.empty())
+      {
+        scriptPath = project_path;
+      }
+
+      replay_frame_times_.clear();
+      recorder_mode_ = RecorderMode::REPLAYING;
+
+      utility::LogDebug("Replaying input from \"{}\".", replay_path.string());
+    }
+    else if (!record_path.empty())
+    {
+      recording_file_.open(record_path, std::ios::out | std::ios::trunc | std::ios::binary);
+
+      if (!recording_file_.is_open())
+      {
+        utility::LogError("Failed to open input recording \"{}\".", record_path.string());
+
+        return;
+      }
+
+      recording_seed_ = std::random_device()();
+      WriteRecordingHeader(scriptPath);
+      recorder_mode_ = RecorderMode::RECORDING;
+
+      utility::LogDebug("Recording input to \"{}\".", record_path.string());
+    }
+    else
+    {
+      return;
+    }
+
+    recorded_frame_ = { 0, 0, glm::ivec2(0), glm::ivec2(0), 0, false, {} };
+    recorded_key_state_.assign(RECORDING_KEY_STATE_SIZE, 0);
+    replay_event_index_ = 0;
+
+    // Lua's timers follow the recorded timesteps, so that they measure the same durations when replaying.
+    usertypes::frame_clock_point = usertypes::TimePoint();
+    usertypes::use_frame_clock = true;
+  }
+
+  void CleanUpInputRecorder()
+  {
+    if (recorder_mode_ == RecorderMode::REPLAYING)
+    {
+      ReportReplay();
+    }
+
+    recording_file_.close();
+    recorder_mode_ = RecorderMode::NONE;
+    usertypes::use_frame_clock = false;
+  }
+
+  bool IsReplaying()
+  {
+    return recorder_mode_ == RecorderMode::REPLAYING;
+  }
+
+  void ApplyRecordingSeed()
+  {
+    if (recorder_mode_ == RecorderMode::NONE)
+    {
+      return;
+    }
+
+    srand(recording_seed_);
+
+    sol::function randomseed = (*scripting::lua_state)["math"]["randomseed"];
+    randomseed(recording_seed_);
+  }
+
+  bool StartInputFrame()
+  {
+    switch (recorder_mode_)
+    {
+      case RecorderMode::RECORDING:
+        recorded_frame_.events_.clear();
+
+        return true;
+      case RecorderMode::REPLAYING:
+        // Using the side-effect of SDL_QuitRequested() calling SDL_PumpEvents(), so that the replay can still be stopped early before the other events are discarded.
+        if (SDL_QuitRequested())
+        {
+          return false;
+        }
+
+        SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+        if (replay_frame_times_.empty())
+        {
+          replay_start_ = usertypes::Clock::now();
+          replay_frame_point_ = replay_start_;
+        }
+
+        replay_event_index_ = 0;
+
+        return ReadRecordedFrame();
+      default:
+        return true;
+    }
+  }
+
+  void RecordInputState()
+  {
+    if (recorder_mode_ != RecorderMode::RECORDING)
+    {
+      return;
+    }
+
+    recorded_frame_.mouse_state_ = events::current_mouse_state;
+    recorded_frame_.mouse_position_ = events::mouse_position;
+    recorded_frame_.mouse_position_delta_ = events::mouse_position_delta;
+    recorded_frame_.mouse_focus_window_id_ = events::mouse_focus_window_id;
+
+    const size_t key_count = std::min((size_t)events::key_state_size, RECORDING_KEY_STATE_SIZE);
+    recorded_frame_.key_state_changed_ = !std::equal(events::current_key_state, events::current_key_state + key_count, recorded_key_state_.begin());
+
+    if (recorded_frame_.key_state_changed_)
+    {
+      std::copy(events::current_key_state, events::current_key_state + key_count, recorded_key_state_.begin());
+    }
+  }
+
+  void ReplayInputState()
+  {
+    events::current_mouse_state = recorded_frame_.mouse_state_;
+    events::mouse_position = recorded_frame_.mouse_position_;
+    events::mouse_position_delta = recorded_frame_.mouse_position_delta_;
+    events::mouse_focus_window_id = recorded_frame_.mouse_focus_window_id_;
+    events::current_key_state = recorded_key_state_.data();
+  }
+
+  bool PollEvent(SDL_Event& event)
+  {
+    if (recorder_mode_ == RecorderMode::REPLAYING)
+    {
+      if (replay_event_index_ >= recorded_frame_.events_.size())
+      {
+        return false;
+      }
+
+      event = recorded_frame_.events_[replay_event_index_++];
+
+      return true;
+    }
+
+    if (SDL_PollEvent(&event) == 0)
+    {
+      return false;
+    }
+
+    if (recorder_mode_ == RecorderMode::RECORDING && IsRecordableEvent(event))
+    {
+      recorded_frame_.events_.push_back(event);
+    }
+
+    return true;
+  }
+
+  uint64_t RecordTimestep(uint64_t timestep)
+  {
+    switch (recorder_mode_)
+    {
+      case RecorderMode::RECORDING:
+        recorded_frame_.timestep_ = timestep;
+        usertypes::AdvanceFrameClock(timestep);
+
+        return timestep;
+      case RecorderMode::REPLAYING:
+        usertypes::AdvanceFrameClock(recorded_frame_.timestep_);
+
+        return recorded_frame_.timestep_;
+      default:
+        return timestep;
+    }
+  }
+
+  void EndInputFrame()
+  {
+    switch (recorder_mode_)
+    {
+      case RecorderMode::RECORDING:
+        WriteRecordedFrame();
+
+        break;
+      case RecorderMode::REPLAYING:
+      {
+        const usertypes::TimePoint now = usertypes::Clock::now();
+        replay_frame_times_.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - replay_frame_point_).count());
+        replay_frame_point_ = now;
+
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  bool IsRecordableEvent(const SDL_Event& event)
+  {
+    switch (event.type)
+    {
+      case SDL_DROPFILE:
+      case SDL_DROPTEXT:
+      case SDL_SYSWMEVENT:
+        return false;
+      default:
+        return event.type < SDL_USEREVENT;
+    }
+  }
+
+  bool ReadRecordingHeader(std::filesystem::path& project_path)
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t event_size;
+    uint32_t key_state_size;
+    uint32_t path_length;
+
+    recording_file_.read(magic, sizeof(magic));
+    recording_file_.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+    recording_file_.read(reinterpret_cast<char*>(&event_size), sizeof(uint32_t));
+    recording_file_.read(reinterpret_cast<char*>(&key_state_size), sizeof(uint32_t));
+    recording_file_.read(reinterpret_cast<char*>(&recording_seed_), sizeof(uint32_t));
+    recording_file_.read(reinterpret_cast<char*>(&path_length), sizeof(uint32_t));
+
+    if (!recording_file_ || std::memcmp(magic, RECORDING_FILE_MAGIC, sizeof(magic)) != 0)
+    {
+      utility::LogError("{} is not an input recording!", replay_path.string());
+
+      return false;
+    }
+    else if (version != RECORDING_FILE_VERSION)
+    {
+      utility::LogError("Input recording {} has unsupported version {}!", replay_path.string(), version);
+
+      return false;
+    }
+    else if (event_size != sizeof(SDL_Event) || key_state_size != RECORDING_KEY_STATE_SIZE)
+    {
+      utility::LogError("Input recording {} was made with an incompatible version of SDL!", replay_path.string());
+
+      return false;
+    }
+
+    std::string project_string(path_length, '\0');
+    recording_file_.read(project_string.data(), path_length);
+
+    if (!recording_file_)
+    {
+      utility::LogError("Input recording {} ends part-way through its header!", replay_path.string());
+
+      return false;
+    }
+
+    project_path = std::filesystem::path(project_string);
+
+    return true;
+  }
+
+  void WriteRecordingHeader(const std::filesystem::path& project_path)
+  {
+    const uint32_t event_size = sizeof(SDL_Event);
+    const uint32_t key_state_size = RECORDING_KEY_STATE_SIZE;
+    const std::string project_string = project_path.string();
+    const uint32_t path_length = (uint32_t)project_string.size();
+
+    recording_file_.write(RECORDING_FILE_MAGIC, sizeof(RECORDING_FILE_MAGIC));
+    recording_file_.write(reinterpret_cast<const char*>(&RECORDING_FILE_VERSION), sizeof(uint32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&event_size), sizeof(uint32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&key_state_size), sizeof(uint32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&recording_seed_), sizeof(uint32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&path_length), sizeof(uint32_t));
+    recording_file_.write(project_string.data(), path_length);
+  }
+
+  bool ReadRecordedFrame()
+  {
+    uint8_t key_state_changed;
+    uint32_t event_count;
+
+    recording_file_.read(reinterpret_cast<char*>(&recorded_frame_.timestep_), sizeof(uint64_t));
+
+    // Running out of data at the start of a frame is the normal end of a recording.
+    if (!recording_file_)
+    {
+      return false;
+    }
+
+    recording_file_.read(reinterpret_cast<char*>(&recorded_frame_.mouse_state_), sizeof(Uint32));
+    recording_file_.read(reinterpret_cast<char*>(&recorded_frame_.mouse_position_.x), sizeof(int32_t));
+    recording_file_.read(reinterpret_cast<char*>(&recorded_frame_.mouse_position_.y), sizeof(int32_t));
+    recording_file_.read(reinterpret_cast<char*>(&recorded_frame_.mouse_position_delta_.x), sizeof(int32_t));
+    recording_file_.read(reinterpret_cast<char*>(&recorded_frame_.mouse_position_delta_.y), sizeof(int32_t));
+    recording_file_.read(reinterpret_cast<char*>(&recorded_frame_.mouse_focus_window_id_), sizeof(Uint32));
+    recording_file_.read(reinterpret_cast<char*>(&key_state_changed), sizeof(uint8_t));
+
+    recorded_frame_.key_state_changed_ = key_state_changed != 0;
+
+    if (recorded_frame_.key_state_changed_)
+    {
+      recording_file_.read(reinterpret_cast<char*>(recorded_key_state_.data()), RECORDING_KEY_STATE_SIZE);
+    }
+
+    recording_file_.read(reinterpret_cast<char*>(&event_count), sizeof(uint32_t));
+
+    if (!recording_file_ || event_count > RECORDING_MAX_FRAME_EVENTS)
+    {
+      utility::LogWarn("Input recording {} ends part-way through a frame, stopping the replay.", replay_path.string());
+
+      return false;
+    }
+
+    recorded_frame_.events_.resize(event_count);
+    recording_file_.read(reinterpret_cast<char*>(recorded_frame_.events_.data()), event_count * sizeof(SDL_Event));
+
+    if (!recording_file_)
+    {
+      utility::LogWarn("Input recording {} ends part-way through a frame, stopping the replay.", replay_path.string());
+
+      return false;
+    }
+
+    return true;
+  }
+
+  void WriteRecordedFrame()
+  {
+    const uint8_t key_state_changed = recorded_frame_.key_state_changed_ ? 1 : 0;
+    const uint32_t event_count = (uint32_t)recorded_frame_.events_.size();
+
+    recording_file_.write(reinterpret_cast<const char*>(&recorded_frame_.timestep_), sizeof(uint64_t));
+    recording_file_.write(reinterpret_cast<const char*>(&recorded_frame_.mouse_state_), sizeof(Uint32));
+    recording_file_.write(reinterpret_cast<const char*>(&recorded_frame_.mouse_position_.x), sizeof(int32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&recorded_frame_.mouse_position_.y), sizeof(int32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&recorded_frame_.mouse_position_delta_.x), sizeof(int32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&recorded_frame_.mouse_position_delta_.y), sizeof(int32_t));
+    recording_file_.write(reinterpret_cast<const char*>(&recorded_frame_.mouse_focus_window_id_), sizeof(Uint32));
+    recording_file_.write(reinterpret_cast<const char*>(&key_state_changed), sizeof(uint8_t));
+
+    if (recorded_frame_.key_state_changed_)
+    {
+      recording_file_.write(reinterpret_cast<const char*>(recorded_key_state_.data()), RECORDING_KEY_STATE_SIZE);
+    }
+
+    recording_file_.write(reinterpret_cast<const char*>(&event_count), sizeof(uint32_t));
+    recording_file_.write(reinterpret_cast<const char*>(recorded_frame_.events_.data()), event_count * sizeof(SDL_Event));
+  }
+
+  double GetReplayFrameTimePercentile(double percentile)
+  {
+    if (replay_frame_times_.empty())
+    {
+      return 0.0;
+    }
+
+    std::vector<uint64_t> sorted_times = replay_frame_times_;
+
+    const size_t rank = (size_t)(std::clamp(percentile, 0.0, 100.0) / 100.0 * (double)(sorted_times.size() - 1) + 0.5);
+    std::nth_element(sorted_times.begin(), sorted_times.begin() + rank, sorted_times.end());
+
+    return (double)sorted_times[rank] / (double)usertypes::NANOSECONDS_PER_MILLISECOND;
+  }
+
+  void ReportReplay()
+  {
+    if (replay_frame_times_.empty())
+    {
+      utility::LogWarn("No frames were replayed from \"{}\".", replay_path.string());
+
+      return;
+    }
+
+    const size_t frame_count = replay_frame_times_.size();
+    const double seconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(replay_frame_point_ - replay_start_).count() / usertypes::NANOSECONDS_PER_SECOND;
+    // A replay of a few empty frames can finish within the clock's resolution.
+    const double fps = seconds > 0.0 ? (double)frame_count / seconds : 0.0;
+    const double p50 = GetReplayFrameTimePercentile(50.0);
+    const double p99 = GetReplayFrameTimePercentile(99.0);
+    const double max = GetReplayFrameTimePercentile(100.0);
+
+    utility::LogInfo("Replayed {} frames in {:.3f}s: {:.1f} FPS, p50 {:.3f}ms, p99 {:.3f}ms, max {:.3f}ms.", frame_count, seconds, fps, p50, p99, max);
+
+    if (replay_report_path.empty())
+    {
+      return;
+    }
+
+    std::ofstream report_file(replay_report_path, std::ios::out | std::ios::trunc);
+
+    if (!report_file.is_open())
+    {
+      utility::LogError("Failed to open replay report \"{}\".", replay_report_path.string());
+
+      return;
+    }
+
+    report_file << std::fixed << std::setprecision(3);
+    report_file << "{\n";
+    report_file << "  \"recording\": ";
+    WriteTraceString(report_file, replay_path.filename().string());
+    report_file << ",\n";
+    report_file << "  \"frames\": " << frame_count << ",\n";
+    report_file << "  \"seconds\": " << seconds << ",\n";
+    report_file << "  \"fps\": " << fps << ",\n";
+    report_file << "  \"unit\": \"ms\",\n";
+    report_file << "  \"p50\": " << p50 << ",\n";
+    report_file << "  \"p99\": " << p99 << ",\n";
+    report_file << "  \"max\": " << max << "\n";
+    report_file << "}\n";
+  }
+}
@@ -0,0 +1,164 @@
+/// @author James Holtom
+
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../usertypes/Timer.h"
+#include "../utility/SDLUtils.h"
+
+namespace term_engine::system {
+  struct RecordedFrame;
+
+  /// @brief The "magic number" at the start of every input recording, used to check that a file is a recording.
+  constexpr char RECORDING_FILE_MAGIC[4] = { 'T', 'E', 'I', 'R' };
+  /// @brief The version of the input recording format. This is increased whenever the layout of the file changes.
+  constexpr uint32_t RECORDING_FILE_VERSION = 2;
+  /// @brief The number of key states stored for each frame, which is the size of SDL's internal array of key states.
+  constexpr size_t RECORDING_KEY_STATE_SIZE = SDL_NUM_SCANCODES;
+  /// @brief The most events that can be stored for a single frame. This is only used to catch corrupted recordings.
+  constexpr uint32_t RECORDING_MAX_FRAME_EVENTS = 65536;
+
+  /// @brief Defines if input is being recorded, replayed, or neither.
+  enum RecorderMode { NONE = 0, RECORDING = 1, REPLAYING = 2 };
+
+  /// @brief The input and timestep of a single frame.
+  struct RecordedFrame {
+    /// @brief The time since the last frame, in nanoseconds (ns).
+    uint64_t timestep_;
+    /// @brief A bitfield representing the mouse button states.
+    Uint32 mouse_state_;
+    /// @brief The location of the mouse, in relation to the window.
+    glm::ivec2 mouse_position_;
+    /// @brief How far the mouse moved within the window.
+    glm::ivec2 mouse_position_delta_;
+    /// @brief The ID of the window that had mouse focus, or 0 if no window had it. Windows are created in the same order when replaying, so they are given the same IDs.
+    Uint32 mouse_focus_window_id_;
+    /// @brief Did the key states change since the last frame? The key states are only stored in the file when they change.
+    bool key_state_changed_;
+    /// @brief The SDL events that were polled.
+    std::vector<SDL_Event> events_;
+  };
+
+  /// @brief Is input being recorded, replayed, or neither?
+  inline RecorderMode recorder_mode_ = RecorderMode::NONE;
+  /// @brief The file that input is recorded to, or replayed from.
+  inline std::fstream recording_file_;
+  /// @brief The seed given to the random number generators, so that anything random happens the same way when replaying.
+  inline uint32_t recording_seed_ = 0;
+  /// @brief The frame that is being recorded or replayed.
+  inline RecordedFrame recorded_frame_;
+  /// @brief The key states of the most recent frame. When replaying, the input manager reads the key states from here instead of from SDL.
+  inline std::vector<Uint8> recorded_key_state_;
+  /// @brief The index of the next event to return from the replayed frame.
+  inline size_t replay_event_index_ = 0;
+  /// @brief The point in time that the first replayed frame started at.
+  inline usertypes::TimePoint replay_start_;
+  /// @brief The point in time that the last replayed frame ended at.
+  inline usertypes::TimePoint replay_frame_point_;
+  /// @brief The time that each replayed frame took, in nanoseconds (ns).
+  inline std::vector<uint64_t> replay_frame_times_;
+
+  /**
+   * @brief Opens the file given with the "--record" or "--replay" flag, and prepares to record or replay input.
+   * @details When replaying, the project that was recorded is run if no project was given, and the frame rate isn't capped.
+   */
+  void InitInputRecorder();
+
+  /// @brief Closes the recording, and reports how quickly the frames were replayed.
+  void CleanUpInputRecorder();
+
+  /**
+   * @brief Returns if input is being replayed.
+   * 
+   * @returns If input is being replayed.
+   */
+  bool IsReplaying();
+
+  /// @brief Seeds the random number generators in C++ and Lua with the recording's seed, if input is being recorded or replayed.
+  void ApplyRecordingSeed();
+
+  /**
+   * @brief Starts recording or replaying the input of a new frame.
+   * @details When replaying, any events from the real windows are discarded, so that only the recorded events are handled.
+   * 
+   * @returns If there is input for the frame. This is only false when a replay has run out of recorded frames, or was asked to quit early.
+   */
+  bool StartInputFrame();
+
+  /// @brief Records the keyboard and mouse states that the input manager read from SDL for this frame.
+  void RecordInputState();
+
+  /// @brief Sets the input manager's keyboard and mouse states to the ones recorded for this frame.
+  void ReplayInputState();
+
+  /**
+   * @brief Polls the next event for this frame, recording it if input is being recorded.
+   * @details When replaying, the recorded events are returned instead of SDL's.
+   * 
+   * @param[out] event The event that was polled.
+   * @returns If an event was polled.
+   */
+  bool PollEvent(SDL_Event& event);
+
+  /**
+   * @brief Records the timestep of this frame, and moves the frame clock forward by it.
+   * 
+   * @param[in] timestep The time since the last frame, in nanoseconds (ns).
+   * @returns The timestep to simulate the frame with. When replaying, this is the recorded timestep instead of the given one.
+   */
+  uint64_t RecordTimestep(uint64_t timestep);
+
+  /// @brief Finishes the frame, writing it to the recording or timing how long it took to replay.
+  void EndInputFrame();
+
+  /**
+   * @brief Checks if an event can be stored in a recording. Events that point to data outside of the event (e.g. dropped files) can't be.
+   * 
+   * @param[in] event The event to check.
+   * @returns If the event can be recorded.
+   */
+  bool IsRecordableEvent(const SDL_Event& event);
+
+  /**
+   * @brief Reads and checks the header of the recording.
+   * 
+   * @param[out] project_path The path of the project that was recorded.
+   * @returns If the header was successfully read, and is from a compatible recording.
+   */
+  bool ReadRecordingHeader(std::filesystem::path& project_path);
+
+  /**
+   * @brief Writes the header of the recording.
+   * 
+   * @param[in] project_path The path of the project that is being recorded.
+   */
+  void WriteRecordingHeader(const std::filesystem::path& project_path);
+
+  /**
+   * @brief Reads the next frame from the recording.
+   * 
+   * @returns If a frame was read, or false if there are no frames left.
+   */
+  bool ReadRecordedFrame();
+
+  /// @brief Writes the frame being recorded to the recording.
+  void WriteRecordedFrame();
+
+  /**
+   * @brief Retrieves the frame time that the given percentage of replayed frames took at most.
+   * 
+   * @param[in] percentile The percentile to find, from 0 to 100.
+   * @returns The frame time, in milliseconds (ms), or 0 if no frames were replayed.
+   */
+  double GetReplayFrameTimePercentile(double percentile);
+
+  /// @brief Logs how quickly the frames were replayed, and writes it to the file given with the "--replay-report" flag.
+  void ReportReplay();
+}
+
+#endif // ! INPUT_RECORDER_H
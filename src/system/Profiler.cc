@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include "Profiler.h"
+#include "CLArguments.h"
+#include "FPSManager.h"
+#include "Tracer.h"
+#include "../scripting/ScriptingInterface.h"
+#include "../utility/ImGuiUtils.h"
+#include "../utility/LogUtils.h"
+
+namespace term_engine::system {
+  ProfileScope::ProfileScope(ProfileZone zone) :
+    zone_(zone),
+    start_(usertypes::Clock::now())
+  {}
+
+  ProfileScope::~ProfileScope()
+  {
+    const usertypes::TimePoint end = usertypes::Clock::now();
+
+    AddZoneTime(zone_, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count());
+
+    if (is_tracing_)
+    {
+      AddTraceEvent(PROFILE_ZONE_NAMES[(size_t)zone_], "", start_, end);
+    }
+  }
+
+  void InitProfiler()
+  {
+    for (std::atomic<uint64_t>& zone_time : profile_zone_times_)
+    {
+      zone_time.store(0, std::memory_order_relaxed);
+    }
+
+    profile_frame_count_.store(0, std::memory_order_release);
+    profile_frame_point_ = usertypes::Clock::now();
+
+    utility::LogDebug("Started profiler.");
+  }
+
+  void CleanUpProfiler()
+  {
+    if (!profile_path.empty())
+    {
+      WriteProfileCSV(profile_path);
+    }
+  }
+
+  void AddZoneTime(ProfileZone zone, uint64_t time)
+  {
+    profile_zone_times_[(size_t)zone].fetch_add(time, std::memory_order_relaxed);
+  }
+
+  void EndProfileFrame(uint64_t frame)
+  {
+    const usertypes::TimePoint now = usertypes::Clock::now();
+    const uint64_t count = profile_frame_count_.load(std::memory_order_relaxed);
+    ProfileFrame& profile_frame = profile_frames_[count % PROFILE_FRAME_SAMPLES];
+
+    profile_frame.frame_ = frame;
+    profile_frame.frame_time_ = std::chrono::duration_cast<std::chrono::nanoseconds>(now - profile_frame_point_).count();
+
+    // Time added by the render thread after this point is counted towards the next frame, as it overlaps with it.
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+    {
+      profile_frame.zone_times_[zone] = profile_zone_times_[zone].exchange(0, std::memory_order_relaxed);
+    }
+
+    profile_frame_count_.store(count + 1, std::memory_order_release);
+    profile_frame_point_ = now;
+  }
+
+  const ProfileFrame* GetLastProfileFrame()
+  {
+    const uint64_t count = profile_frame_count_.load(std::memory_order_acquire);
+
+    if (count == 0)
+    {
+      return nullptr;
+    }
+
+    return &profile_frames_[(count - 1) % PROFILE_FRAME_SAMPLES];
+  }
+
+  sol::table GetLastProfile()
+  {
+    static const ProfileFrame empty_frame = { 0, 0, {} };
+    const ProfileFrame* profile_frame = GetLastProfileFrame();
+
+    if (profile_frame == nullptr)
+    {
+      profile_frame = &empty_frame;
+    }
+
+    sol::table profile = scripting::lua_state->create_table_with(
+      "frame", profile_frame->frame_,
+      "total", (double)profile_frame->frame_time_ / (double)usertypes::NANOSECONDS_PER_MILLISECOND);
+
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+    {
+      profile[PROFILE_ZONE_NAMES[zone]] = (double)profile_frame->zone_times_[zone] / (double)usertypes::NANOSECONDS_PER_MILLISECOND;
+    }
+
+    return profile;
+  }
+
+  bool WriteProfileCSV(const std::filesystem::path& filepath)
+  {
+    std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+      utility::LogError("Failed to open profile file \"{}\".", filepath.string());
+
+      return false;
+    }
+
+    file << "frame,total";
+
+    for (const char* zone_name : PROFILE_ZONE_NAMES)
+    {
+      file << "," << zone_name;
+    }
+
+    file << "\n";
+
+    const uint64_t count = profile_frame_count_.load(std::memory_order_acquire);
+    const uint64_t first = count > PROFILE_FRAME_SAMPLES ? count - PROFILE_FRAME_SAMPLES : 0;
+
+    for (uint64_t index = first; index < count; ++index)
+    {
+      const ProfileFrame& profile_frame = profile_frames_[index % PROFILE_FRAME_SAMPLES];
+
+      file << profile_frame.frame_ << "," << (double)profile_frame.frame_time_ / (double)usertypes::NANOSECONDS_PER_MILLISECOND;
+
+      for (uint64_t zone_time : profile_frame.zone_times_)
+      {
+        file << "," << (double)zone_time / (double)usertypes::NANOSECONDS_PER_MILLISECOND;
+      }
+
+      file << "\n";
+    }
+
+    utility::LogInfo("Wrote {} profiled frames to \"{}\".", count - first, filepath.string());
+
+    return true;
+  }
+
+  void UpdateProfilerDebugInfo()
+  {
+    const uint64_t count = profile_frame_count_.load(std::memory_order_acquire);
+    const uint64_t first = count > PROFILE_FRAME_SAMPLES ? count - PROFILE_FRAME_SAMPLES : 0;
+    std::array<uint64_t, PROFILE_ZONE_COUNT> zone_totals = {};
+    uint64_t highest_time = 0;
+
+    for (uint64_t index = first; index < count; ++index)
+    {
+      const ProfileFrame& profile_frame = profile_frames_[index % PROFILE_FRAME_SAMPLES];
+      uint64_t stacked_time = 0;
+
+      for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+      {
+        stacked_time += profile_frame.zone_times_[zone];
+        zone_totals[zone] += profile_frame.zone_times_[zone];
+      }
+
+      highest_time = std::max(highest_time, stacked_time);
+    }
+
+    // The graph is scaled to fit the slowest frame, but never shorter than a frame at the target frame rate, so that quick frames don't look slow.
+    const double target_time = IsUsingTargetFPS() ? usertypes::NANOSECONDS_PER_SECOND / (double)GetTargetFPS() : 0.0;
+    const double graph_time = std::max({ (double)highest_time, target_time, (double)usertypes::NANOSECONDS_PER_MILLISECOND });
+
+    ImGui::Text("Graph Height: %.3fms", graph_time / (double)usertypes::NANOSECONDS_PER_MILLISECOND);
+
+    const ImVec2 graph_size = ImVec2(ImGui::GetContentRegionAvail().x, PROFILE_GRAPH_HEIGHT);
+    const ImVec2 graph_start = ImGui::GetCursorScreenPos();
+    const ImVec2 origin = ImVec2(graph_start.x, graph_start.y + graph_size.y);
+    const float bar_width = graph_size.x / (float)PROFILE_FRAME_SAMPLES;
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    draw_list->AddRectFilled(graph_start, ImVec2(graph_start.x + graph_size.x, origin.y), IM_COL32(32, 32, 32, 255));
+
+    for (uint64_t index = first; index < count; ++index)
+    {
+      const ProfileFrame& profile_frame = profile_frames_[index % PROFILE_FRAME_SAMPLES];
+      const float bar_x = origin.x + (float)(index - first) * bar_width;
+      float bar_y = origin.y;
+
+      for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+      {
+        const float bar_height = (float)((double)profile_frame.zone_times_[zone] / graph_time) * graph_size.y;
+
+        if (bar_height > 0.0f)
+        {
+          draw_list->AddRectFilled(ImVec2(bar_x, bar_y - bar_height), ImVec2(bar_x + std::max(bar_width, 1.0f), bar_y), ImColor::HSV((float)zone / (float)PROFILE_ZONE_COUNT, 0.6f, 0.9f));
+          bar_y -= bar_height;
+        }
+      }
+    }
+
+    if (target_time > 0.0)
+    {
+      const float target_y = origin.y - (float)(target_time / graph_time) * graph_size.y;
+
+      draw_list->AddLine(ImVec2(origin.x, target_y), ImVec2(origin.x + graph_size.x, target_y), IM_COL32(255, 255, 255, 128));
+    }
+
+    ImGui::Dummy(graph_size);
+
+    const ProfileFrame* last_frame = GetLastProfileFrame();
+    const uint64_t frames = count - first;
+
+    for (size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+    {
+      const double last_time = last_frame != nullptr ? (double)last_frame->zone_times_[zone] / (double)usertypes::NANOSECONDS_PER_MILLISECOND : 0.0;
+      const double average_time = frames > 0 ? (double)zone_totals[zone] / (double)frames / (double)usertypes::NANOSECONDS_PER_MILLISECOND : 0.0;
+
+      ImGui::ColorButton(PROFILE_ZONE_NAMES[zone], ImColor::HSV((float)zone / (float)PROFILE_ZONE_COUNT, 0.6f, 0.9f), ImGuiColorEditFlags_NoTooltip, ImVec2(12.0f, 12.0f));
+      ImGui::SameLine();
+      ImGui::Text("%s: %.3fms (Average: %.3fms)", PROFILE_ZONE_NAMES[zone], last_time, average_time);
+    }
+  }
+}
@@ -0,0 +1,118 @@
+/// @author James Holtom
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include "../usertypes/Timer.h"
+#include "../utility/SolUtils.h"
+
+namespace term_engine::system {
+  /// @brief Defines the phases of a frame that are timed by the profiler.
+  enum class ProfileZone : size_t { EVENT_PUMP = 0, SDL_EVENTS = 1, LISTENERS = 2, ON_LOOP = 3, UPDATE_OBJECTS = 4, VERTEX_BUILD = 5, GL_UPLOAD = 6, SWAP = 7, CLEANUP = 8, IMGUI = 9 };
+
+  /// @brief The number of zones timed by the profiler.
+  constexpr size_t PROFILE_ZONE_COUNT = (size_t)ProfileZone::IMGUI + 1;
+  /// @brief The number of recent frames kept by the profiler.
+  constexpr size_t PROFILE_FRAME_SAMPLES = 1024;
+  /// @brief The height of the profiler's frame time graph, in pixels (px).
+  constexpr float PROFILE_GRAPH_HEIGHT = 120.0f;
+  /// @brief The names of each zone, which are used as the keys in Lua and the column headers in CSV files.
+  constexpr std::array<const char*, PROFILE_ZONE_COUNT> PROFILE_ZONE_NAMES = { "eventPump", "sdlEvents", "listeners", "onLoop", "updateObjects", "vertexBuild", "glUpload", "swap", "cleanup", "imgui" };
+
+  /// @brief The timings recorded by the profiler for a single frame.
+  struct ProfileFrame {
+    /// @brief The number of the frame.
+    uint64_t frame_;
+    /// @brief The total time the frame took, including any time spent waiting for the next frame, in nanoseconds (ns).
+    uint64_t frame_time_;
+    /// @brief The time spent in each zone during the frame, in nanoseconds (ns).
+    std::array<uint64_t, PROFILE_ZONE_COUNT> zone_times_;
+  };
+
+  /**
+   * @brief Times a zone of the frame for as long as it is in scope.
+   * @details The time is added onto the zone's time for the current frame, so a zone can be entered multiple times in a frame (e.g. once per event), and from the render thread. If a trace is being recorded, the zone is also added to the trace.
+   */
+  class ProfileScope {
+  public:
+    /**
+     * @brief Starts timing the zone.
+     * 
+     * @param[in] zone The zone to time.
+     */
+    ProfileScope(ProfileZone zone);
+
+    /// @brief Stops timing the zone, and adds the time taken to the current frame.
+    ~ProfileScope();
+
+  protected:
+    /// @brief The zone being timed.
+    ProfileZone zone_;
+    /// @brief The point in time that the zone was entered.
+    usertypes::TimePoint start_;
+  };
+
+  /**
+   * @brief The recent frames recorded by the profiler. This is used as a ring buffer.
+   * @note Frames are only written by the main thread, and are only safe to read from the main thread.
+   */
+  inline std::array<ProfileFrame, PROFILE_FRAME_SAMPLES> profile_frames_;
+  /// @brief The number of frames that have been recorded. The next frame is written to _profile_frames_ at this count, modulo _PROFILE_FRAME_SAMPLES_.
+  inline std::atomic<uint64_t> profile_frame_count_ = 0;
+  /// @brief The time spent in each zone during the current frame, in nanoseconds (ns). These are atomic, so that the render thread can add to them without locking.
+  inline std::array<std::atomic<uint64_t>, PROFILE_ZONE_COUNT> profile_zone_times_;
+  /// @brief The point in time that the last frame was recorded at.
+  inline usertypes::TimePoint profile_frame_point_;
+
+  /// @brief Clears the recorded frames, and starts timing the first frame.
+  void InitProfiler();
+
+  /// @brief Writes the recorded frames to a CSV file, if a file was given with the "--profile" flag.
+  void CleanUpProfiler();
+
+  /**
+   * @brief Adds time spent in a zone to the current frame.
+   * 
+   * @param[in] zone The zone to add the time to.
+   * @param[in] time The time spent in the zone, in nanoseconds (ns).
+   */
+  void AddZoneTime(ProfileZone zone, uint64_t time);
+
+  /**
+   * @brief Records the timings of the current frame, and starts timing the next one.
+   * 
+   * @param[in] frame The number of the frame that has ended.
+   */
+  void EndProfileFrame(uint64_t frame);
+
+  /**
+   * @brief Returns the last frame recorded by the profiler.
+   * 
+   * @returns A raw pointer to the frame, or a null pointer if no frames have been recorded.
+   */
+  const ProfileFrame* GetLastProfileFrame();
+
+  /**
+   * @brief Returns the timings of the last frame to Lua.
+   * 
+   * @returns A table containing the frame number, the total frame time and the time spent in each zone, all in milliseconds (ms).
+   */
+  sol::table GetLastProfile();
+
+  /**
+   * @brief Writes the recorded frames to a CSV file, with a row for each frame and a column for each zone.
+   * 
+   * @param[in] filepath The path to the file to write to.
+   * @returns If the file was successfully written.
+   */
+  bool WriteProfileCSV(const std::filesystem::path& filepath);
+
+  /// @brief Draws the recent frames to the debug window, as a graph of the time spent in each zone stacked on top of each other.
+  void UpdateProfilerDebugInfo();
+}
+
+#endif // ! PROFILER_H
@@ -0,0 +1,278 @@
+#include <algorithm>
+#include "TimerWheel.h"
+
+namespace term_engine::system {
+  TimerWheel::TimerWheel() :
+    timers_(),
+    free_timers_(),
+    time_(0),
+    timer_count_(0)
+  {
+    lists_.fill(NULL_TIMER_INDEX);
+    level_timer_counts_.fill(0);
+  }
+
+  TimerId TimerWheel::Schedule(uint64_t delay, uint64_t payload)
+  {
+    uint32_t index;
+
+    if (free_timers_.empty())
+    {
+      index = (uint32_t)timers_.size();
+      timers_.push_back({ 0, 0, 0, NULL_TIMER_INDEX, NULL_TIMER_INDEX, NULL_TIMER_INDEX });
+    }
+    else
+    {
+      index = free_timers_.back();
+      free_timers_.pop_back();
+    }
+
+    Timer& timer = timers_[index];
+    timer.due_ = time_ + std::max(delay, (uint64_t)1);
+    timer.payload_ = payload;
+
+    Link(index);
+    ++timer_count_;
+
+    return ((TimerId)timer.generation_ << 32) | index;
+  }
+
+  bool TimerWheel::Cancel(TimerId id)
+  {
+    const uint32_t index = GetIndex(id);
+
+    if (index == NULL_TIMER_INDEX)
+    {
+      return false;
+    }
+
+    Unlink(index);
+    Free(index);
+
+    return true;
+  }
+
+  void TimerWheel::Advance(uint64_t timestep, TimerExpiryList& expired)
+  {
+    const uint64_t end_time = time_ + timestep;
+
+    while (time_ < end_time)
+    {
+      if (timer_count_ == 0)
+      {
+        time_ = end_time;
+
+        break;
+      }
+
+      size_t lowest_level = 0;
+
+      while (level_timer_counts_[lowest_level] == 0)
+      {
+        ++lowest_level;
+      }
+
+      // If the lower levels are empty, nothing can expire or move down until the lowest occupied level next moves its timers down, so skip ahead to that point.
+      if (lowest_level > 0)
+      {
+        const uint64_t next_cascade = (time_ | ((1ULL << (lowest_level * TIMER_WHEEL_SLOT_BITS)) - 1)) + 1;
+
+        if (next_cascade > end_time)
+        {
+          time_ = end_time;
+
+          break;
+        }
+
+        time_ = next_cascade - 1;
+      }
+
+      ++time_;
+
+      // When the slots of a level wrap around, the timers in the next slot of the level above are moved down.
+      for (size_t level = 1; level <= TIMER_WHEEL_LEVELS; ++level)
+      {
+        const uint64_t lower_bits = time_ & ((1ULL << (level * TIMER_WHEEL_SLOT_BITS)) - 1);
+
+        if (lower_bits != 0)
+        {
+          break;
+        }
+
+        if (level == TIMER_WHEEL_LEVELS)
+        {
+          Cascade(TIMER_WHEEL_OVERFLOW_LIST);
+        }
+        else
+        {
+          Cascade(level * TIMER_WHEEL_SLOTS + ((time_ >> (level * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOTS - 1)));
+        }
+      }
+
+      uint32_t index = lists_[time_ & (TIMER_WHEEL_SLOTS - 1)];
+
+      while (index != NULL_TIMER_INDEX)
+      {
+        const uint32_t next = timers_[index].next_;
+
+        expired.push_back({ ((TimerId)timers_[index].generation_ << 32) | index, timers_[index].payload_ });
+        Unlink(index);
+        Free(index);
+
+        index = next;
+      }
+    }
+  }
+
+  uint64_t TimerWheel::GetTimeUntilNextExpiry() const
+  {
+    if (timer_count_ == 0)
+    {
+      return UINT64_MAX;
+    }
+
+    uint64_t time_until_expiry = UINT64_MAX;
+
+    // Timers in the bottom level are due exactly at their slot's time.
+    if (level_timer_counts_[0] > 0)
+    {
+      for (uint64_t offset = 1; offset <= TIMER_WHEEL_SLOTS; ++offset)
+      {
+        if (lists_[(time_ + offset) & (TIMER_WHEEL_SLOTS - 1)] != NULL_TIMER_INDEX)
+        {
+          time_until_expiry = offset;
+
+          break;
+        }
+      }
+    }
+
+    size_t lowest_level = 1;
+
+    while (lowest_level <= TIMER_WHEEL_LEVELS && level_timer_counts_[lowest_level] == 0)
+    {
+      ++lowest_level;
+    }
+
+    // Timers in the upper levels can't expire before the lowest occupied level next moves its timers down.
+    if (lowest_level <= TIMER_WHEEL_LEVELS)
+    {
+      const uint64_t next_cascade = (time_ | ((1ULL << (lowest_level * TIMER_WHEEL_SLOT_BITS)) - 1)) + 1;
+
+      time_until_expiry = std::min(time_until_expiry, next_cascade - time_);
+    }
+
+    return time_until_expiry;
+  }
+
+  uint64_t TimerWheel::GetTime() const
+  {
+    return time_;
+  }
+
+  size_t TimerWheel::GetTimerCount() const
+  {
+    return timer_count_;
+  }
+
+  void TimerWheel::Clear()
+  {
+    timers_.clear();
+    free_timers_.clear();
+    lists_.fill(NULL_TIMER_INDEX);
+    level_timer_counts_.fill(0);
+    time_ = 0;
+    timer_count_ = 0;
+  }
+
+  void TimerWheel::Link(uint32_t index)
+  {
+    Timer& timer = timers_[index];
+    const uint64_t remaining = timer.due_ - time_;
+    size_t list = TIMER_WHEEL_OVERFLOW_LIST;
+
+    // Place the timer in the lowest level that covers the time until it is due.
+    for (size_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+    {
+      const size_t shift = level * TIMER_WHEEL_SLOT_BITS;
+
+      if (remaining < (1ULL << (shift + TIMER_WHEEL_SLOT_BITS)))
+      {
+        list = level * TIMER_WHEEL_SLOTS + ((timer.due_ >> shift) & (TIMER_WHEEL_SLOTS - 1));
+
+        break;
+      }
+    }
+
+    timer.list_ = (uint32_t)list;
+    ++level_timer_counts_[list / TIMER_WHEEL_SLOTS];
+    timer.prev_ = NULL_TIMER_INDEX;
+    timer.next_ = lists_[list];
+
+    if (timer.next_ != NULL_TIMER_INDEX)
+    {
+      timers_[timer.next_].prev_ = index;
+    }
+
+    lists_[list] = index;
+  }
+
+  void TimerWheel::Unlink(uint32_t index)
+  {
+    Timer& timer = timers_[index];
+
+    if (timer.prev_ != NULL_TIMER_INDEX)
+    {
+      timers_[timer.prev_].next_ = timer.next_;
+    }
+    else
+    {
+      lists_[timer.list_] = timer.next_;
+    }
+
+    if (timer.next_ != NULL_TIMER_INDEX)
+    {
+      timers_[timer.next_].prev_ = timer.prev_;
+    }
+
+    --level_timer_counts_[timer.list_ / TIMER_WHEEL_SLOTS];
+    timer.list_ = NULL_TIMER_INDEX;
+    timer.prev_ = NULL_TIMER_INDEX;
+    timer.next_ = NULL_TIMER_INDEX;
+  }
+
+  void TimerWheel::Free(uint32_t index)
+  {
+    ++timers_[index].generation_;
+    free_timers_.push_back(index);
+    --timer_count_;
+  }
+
+  void TimerWheel::Cascade(size_t list)
+  {
+    uint32_t index = lists_[list];
+    lists_[list] = NULL_TIMER_INDEX;
+
+    while (index != NULL_TIMER_INDEX)
+    {
+      const uint32_t next = timers_[index].next_;
+
+      --level_timer_counts_[list / TIMER_WHEEL_SLOTS];
+      Link(index);
+
+      index = next;
+    }
+  }
+
+  uint32_t TimerWheel::GetIndex(TimerId id) const
+  {
+    const uint32_t index = (uint32_t)(id & 0xFFFFFFFF);
+
+    if (id == NULL_TIMER_ID || index >= timers_.size() || timers_[index].generation_ != (uint32_t)(id >> 32) || timers_[index].list_ == NULL_TIMER_INDEX)
+    {
+      return NULL_TIMER_INDEX;
+    }
+
+    return index;
+  }
+}
@@ -0,0 +1,169 @@
+/// @author James Holtom
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace term_engine::system {
+  /// @brief Used to refer to a timer in a timer wheel. The lower 32 bits are the timer's index, and the upper 32 bits are its generation.
+  typedef uint64_t TimerId;
+
+  /// @brief A timer ID that never refers to a timer.
+  constexpr TimerId NULL_TIMER_ID = UINT64_MAX;
+  /// @brief The number of levels in a timer wheel. Each level covers 256 times the range of the level below it.
+  constexpr size_t TIMER_WHEEL_LEVELS = 4;
+  /// @brief The number of bits of the due time used to pick a slot in each level.
+  constexpr size_t TIMER_WHEEL_SLOT_BITS = 8;
+  /// @brief The number of slots in each level.
+  constexpr size_t TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_SLOT_BITS;
+  /// @brief The list that timers are kept in when they are due further ahead than the top level covers.
+  constexpr size_t TIMER_WHEEL_OVERFLOW_LIST = TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS;
+  /// @brief Marks the end of a list of timers.
+  constexpr uint32_t NULL_TIMER_INDEX = UINT32_MAX;
+
+  /// @brief A timer that has expired, which is returned when the timer wheel is advanced.
+  struct TimerExpiry {
+    /// @brief The ID the timer had.
+    TimerId id_;
+    /// @brief The value the timer was scheduled with.
+    uint64_t payload_;
+  };
+
+  /// @brief Used to return the timers that have expired.
+  typedef std::vector<TimerExpiry> TimerExpiryList;
+
+  /**
+   * @brief Schedules timers to expire after a delay, using a hierarchical timer wheel.
+   * @details Each level of the wheel is a ring of slots, where each slot is a linked list of the timers due in it. The bottom level has a slot per millisecond, and each level above has slots 256 times longer.
+   *          As time passes, the timers in each slot of the upper levels are moved down to the level below, until they reach the bottom level and expire.
+   *          Scheduling and cancelling timers takes constant time, and advancing the wheel only touches timers that are expiring or moving down a level. Stretches of time where no timer can expire or move are skipped over.
+   */
+  class TimerWheel {
+  public:
+    /// @brief Constructs the timer wheel.
+    TimerWheel();
+
+    /**
+     * @brief Schedules a timer.
+     * @note Timers are due at least 1ms from now, so that a timer rescheduled as it expires isn't expired again in the same advance.
+     * 
+     * @param[in] delay   The amount of time until the timer expires, in milliseconds (ms).
+     * @param[in] payload The value returned with the timer when it expires.
+     * @returns The ID of the timer.
+     */
+    TimerId Schedule(uint64_t delay, uint64_t payload);
+
+    /**
+     * @brief Cancels a timer, so that it doesn't expire.
+     * 
+     * @param[in] id The ID of the timer.
+     * @returns If a timer was cancelled.
+     */
+    bool Cancel(TimerId id);
+
+    /**
+     * @brief Moves the time of the wheel forward, and returns the timers that expired in that time.
+     * 
+     * @param[in]  timestep The amount of time to move forward by, in milliseconds (ms).
+     * @param[out] expired  The list to add the expired timers to, in the order they were due.
+     */
+    void Advance(uint64_t timestep, TimerExpiryList& expired);
+
+    /**
+     * @brief Returns how long the wheel can be advanced by before any timer can expire.
+     * @details Timers in the upper levels are only placed precisely when they move down, so this may be earlier than the next timer is due, but is never later.
+     * 
+     * @returns The amount of time, in milliseconds (ms), or _UINT64_MAX_ if no timers are scheduled.
+     */
+    uint64_t GetTimeUntilNextExpiry() const;
+
+    /**
+     * @brief Returns the time of the wheel, which is the total time it has been advanced by.
+     * 
+     * @returns The time, in milliseconds (ms).
+     */
+    uint64_t GetTime() const;
+
+    /**
+     * @brief Returns the number of timers that are scheduled.
+     * 
+     * @returns The number of timers.
+     */
+    size_t GetTimerCount() const;
+
+    /// @brief Cancels all timers, and resets the time of the wheel.
+    void Clear();
+
+  protected:
+    /// @brief A timer in the wheel, which is linked to the other timers in the same slot.
+    struct Timer {
+      /// @brief The time the timer is due.
+      uint64_t due_;
+      /// @brief The value returned with the timer when it expires.
+      uint64_t payload_;
+      /// @brief The generation of the timer, which is increased each time it is freed so that old IDs no longer refer to it.
+      uint32_t generation_;
+      /// @brief The list the timer is in, or _NULL_TIMER_INDEX_ if the timer is free.
+      uint32_t list_;
+      /// @brief The previous timer in the list.
+      uint32_t prev_;
+      /// @brief The next timer in the list.
+      uint32_t next_;
+    };
+
+    /// @brief The timers, including free ones that can be reused.
+    std::vector<Timer> timers_;
+    /// @brief The timers that are free to be reused.
+    std::vector<uint32_t> free_timers_;
+    /// @brief The first timer in each slot of each level, followed by the first timer in the overflow list.
+    std::array<uint32_t, TIMER_WHEEL_OVERFLOW_LIST + 1> lists_;
+    /// @brief The current time of the wheel.
+    uint64_t time_;
+    /// @brief The number of timers that are scheduled.
+    size_t timer_count_;
+    /// @brief The number of timers in each level, followed by the number in the overflow list.
+    std::array<size_t, TIMER_WHEEL_LEVELS + 1> level_timer_counts_;
+
+    /**
+     * @brief Adds a timer to the list for its due time.
+     * 
+     * @param[in] index The index of the timer.
+     */
+    void Link(uint32_t index);
+
+    /**
+     * @brief Removes a timer from the list it is in.
+     * 
+     * @param[in] index The index of the timer.
+     */
+    void Unlink(uint32_t index);
+
+    /**
+     * @brief Marks a timer as free, so that it can be reused.
+     * 
+     * @param[in] index The index of the timer.
+     */
+    void Free(uint32_t index);
+
+    /**
+     * @brief Moves each timer in a list into the list for its due time, relative to the current time.
+     * 
+     * @param[in] list The index of the list.
+     */
+    void Cascade(size_t list);
+
+    /**
+     * @brief Returns the index of the timer that the given ID refers to.
+     * 
+     * @param[in] id The ID of the timer.
+     * @returns The index of the timer, or _NULL_TIMER_INDEX_ if the ID does not refer to a scheduled timer.
+     */
+    uint32_t GetIndex(TimerId id) const;
+  };
+}
+
+#endif // ! TIMER_WHEEL_H
@@ -0,0 +1,234 @@
+#include <chrono>
+#include <iomanip>
+#include "Tracer.h"
+#include "CLArguments.h"
+#include "../utility/LogUtils.h"
+
+namespace term_engine::system {
+  TraceScope::TraceScope(const char* name) :
+    name_(name),
+    detail_(),
+    start_()
+  {
+    if (is_tracing_)
+    {
+      start_ = usertypes::Clock::now();
+    }
+  }
+
+  TraceScope::TraceScope(const char* name, const std::string& detail) :
+    name_(name),
+    detail_(),
+    start_()
+  {
+    if (is_tracing_)
+    {
+      detail_ = detail;
+      start_ = usertypes::Clock::now();
+    }
+  }
+
+  TraceScope::~TraceScope()
+  {
+    if (is_tracing_)
+    {
+      AddTraceEvent(name_, detail_, start_, usertypes::Clock::now());
+    }
+  }
+
+  void InitTracer()
+  {
+    if (trace_path.empty())
+    {
+      return;
+    }
+
+    trace_file_.open(trace_path, std::ios::out | std::ios::trunc);
+
+    if (!trace_file_.is_open())
+    {
+      utility::LogError("Failed to open trace file \"{}\".", trace_path.string());
+
+      return;
+    }
+
+    trace_file_ << std::fixed << std::setprecision(3);
+    trace_file_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    trace_start_ = usertypes::Clock::now();
+    trace_has_events_ = false;
+    is_tracing_ = true;
+
+    utility::LogDebug("Started recording trace to \"{}\".", trace_path.string());
+  }
+
+  void CleanUpTracer()
+  {
+    if (!is_tracing_)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(trace_mutex_);
+
+    for (TraceBufferPtr& buffer : trace_buffers_)
+    {
+      WriteTraceBuffer(*buffer);
+    }
+
+    trace_file_ << "\n]}\n";
+    trace_file_.close();
+    is_tracing_ = false;
+
+    utility::LogInfo("Wrote trace to \"{}\".", trace_path.string());
+  }
+
+  void AddTraceEvent(const char* name, const std::string& detail, const usertypes::TimePoint& start, const usertypes::TimePoint& end)
+  {
+    if (thread_trace_buffer_ == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(trace_mutex_);
+
+      trace_buffers_.emplace_back(std::make_unique<TraceBuffer>());
+      thread_trace_buffer_ = trace_buffers_.back().get();
+      thread_trace_buffer_->thread_id_ = (uint32_t)trace_buffers_.size();
+      thread_trace_buffer_->events_.reserve(TRACE_FLUSH_SIZE);
+    }
+
+    thread_trace_buffer_->events_.push_back({ name, detail, start, end });
+
+    if (thread_trace_buffer_->events_.size() >= TRACE_FLUSH_SIZE)
+    {
+      std::lock_guard<std::mutex> lock(trace_mutex_);
+
+      WriteTraceBuffer(*thread_trace_buffer_);
+    }
+  }
+
+  void WriteTraceString(std::ostream& stream, const std::string& text)
+  {
+    constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    const size_t size = text.size();
+    size_t index = 0;
+
+    stream << '"';
+
+    while (index < size)
+    {
+      const unsigned char character = (unsigned char)text[index];
+
+      if (character == '"' || character == '\\')
+      {
+        stream << '\\' << (char)character;
+        ++index;
+      }
+      else if (character < 0x20 || character == 0x7F)
+      {
+        stream << "\\u00" << HEX_DIGITS[character >> 4] << HEX_DIGITS[character & 0xF];
+        ++index;
+      }
+      else if (character < 0x80)
+      {
+        stream << (char)character;
+        ++index;
+      }
+      else
+      {
+        const size_t length = GetUTF8SequenceLength(text, index);
+
+        if (length == 0)
+        {
+          // JSON strings must be valid UTF-8, so each byte that isn't part of a valid sequence is replaced.
+          stream << "\\ufffd";
+          ++index;
+        }
+        else
+        {
+          stream.write(text.data() + index, length);
+          index += length;
+        }
+      }
+    }
+
+    stream << '"';
+  }
+
+  size_t GetUTF8SequenceLength(const std::string& text, size_t index)
+  {
+    const unsigned char lead = (unsigned char)text[index];
+    size_t length;
+    // The range of the second byte is narrower for some lead bytes, to reject overlong encodings, surrogates and code points above U+10FFFF.
+    unsigned char second_min = 0x80;
+    unsigned char second_max = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+      length = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+      length = 3;
+      second_min = lead == 0xE0 ? 0xA0 : 0x80;
+      second_max = lead == 0xED ? 0x9F : 0xBF;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+      length = 4;
+      second_min = lead == 0xF0 ? 0x90 : 0x80;
+      second_max = lead == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+    {
+      return 0;
+    }
+
+    if (index + length > text.size())
+    {
+      return 0;
+    }
+
+    for (size_t offset = 1; offset < length; ++offset)
+    {
+      const unsigned char byte = (unsigned char)text[index + offset];
+      const unsigned char min = offset == 1 ? second_min : 0x80;
+      const unsigned char max = offset == 1 ? second_max : 0xBF;
+
+      if (byte < min || byte > max)
+      {
+        return 0;
+      }
+    }
+
+    return length;
+  }
+
+  void WriteTraceBuffer(TraceBuffer& buffer)
+  {
+    for (const TraceEvent& event : buffer.events_)
+    {
+      // Chrome's trace event format measures time in microseconds (us).
+      const double start = std::chrono::duration<double, std::micro>(event.start_ - trace_start_).count();
+      const double duration = std::chrono::duration<double, std::micro>(event.end_ - event.start_).count();
+
+      if (trace_has_events_)
+      {
+        trace_file_ << ",\n";
+      }
+
+      trace_file_ << "{\"name\":";
+      WriteTraceString(trace_file_, event.name_);
+      trace_file_ << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.thread_id_ << ",\"ts\":" << start << ",\"dur\":" << duration;
+
+      if (!event.detail_.empty())
+      {
+        trace_file_ << ",\"args\":{\"detail\":";
+        WriteTraceString(trace_file_, event.detail_);
+        trace_file_ << "}";
+      }
+
+      trace_file_ << "}";
+      trace_has_events_ = true;
+    }
+
+    buffer.events_.clear();
+  }
+}
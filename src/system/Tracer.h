@@ -0,0 +1,136 @@
+/// @author James Holtom
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../usertypes/Timer.h"
+
+namespace term_engine::system {
+  struct TraceEvent;
+  struct TraceBuffer;
+
+  /// @brief The number of events a thread records before they are written to the trace file.
+  constexpr size_t TRACE_FLUSH_SIZE = 4096;
+
+  /// @brief Unique pointer to a trace buffer.
+  typedef std::unique_ptr<TraceBuffer> TraceBufferPtr;
+
+  /// @brief A zone of time recorded in the trace, which is written as a "complete" event in Chrome's trace event format.
+  struct TraceEvent {
+    /// @brief The name of the zone. This must outlive the trace, e.g. a string literal.
+    const char* name_;
+    /// @brief Extra information about the zone (e.g. the type of event that triggered a listener), or an empty string if there is none.
+    std::string detail_;
+    /// @brief The point in time that the zone was entered.
+    usertypes::TimePoint start_;
+    /// @brief The point in time that the zone was left.
+    usertypes::TimePoint end_;
+  };
+
+  /// @brief The events recorded by a single thread, which are kept until they are written to the trace file.
+  struct TraceBuffer {
+    /// @brief The ID of the thread in the trace, starting from 1.
+    uint32_t thread_id_;
+    /// @brief The events waiting to be written.
+    std::vector<TraceEvent> events_;
+  };
+
+  /**
+   * @brief Records a zone in the trace for as long as it is in scope.
+   * @details If tracing is disabled, this only checks a flag, so it can be left in code that runs every frame.
+   */
+  class TraceScope {
+  public:
+    /**
+     * @brief Starts recording the zone.
+     * 
+     * @param[in] name The name of the zone. This must outlive the trace, e.g. a string literal.
+     */
+    TraceScope(const char* name);
+
+    /**
+     * @brief Starts recording the zone, with extra information about it.
+     * 
+     * @param[in] name   The name of the zone. This must outlive the trace, e.g. a string literal.
+     * @param[in] detail Extra information about the zone, which is only copied if tracing is enabled.
+     */
+    TraceScope(const char* name, const std::string& detail);
+
+    /// @brief Stops recording the zone, and adds it to the trace.
+    ~TraceScope();
+
+  protected:
+    /// @brief The name of the zone.
+    const char* name_;
+    /// @brief Extra information about the zone.
+    std::string detail_;
+    /// @brief The point in time that the zone was entered.
+    usertypes::TimePoint start_;
+  };
+
+  /// @brief Is a trace being recorded? This is only set when the program starts, before any other threads are started.
+  inline bool is_tracing_ = false;
+  /// @brief The point in time that the trace was started, which the times of events are relative to.
+  inline usertypes::TimePoint trace_start_;
+  /// @brief The file that the trace is written to.
+  inline std::ofstream trace_file_;
+  /// @brief Have any events been written to the trace file yet? This is used to separate the events with commas.
+  inline bool trace_has_events_ = false;
+  /// @brief Guards the trace file and the list of trace buffers.
+  inline std::mutex trace_mutex_;
+  /// @brief The trace buffers for each thread that has recorded events. These are kept after their thread stops, so that their remaining events can be written.
+  inline std::vector<TraceBufferPtr> trace_buffers_;
+  /// @brief The calling thread's trace buffer, which is created the first time the thread records an event.
+  inline thread_local TraceBuffer* thread_trace_buffer_ = nullptr;
+
+  /// @brief Opens the trace file and starts recording, if a file was given with the "--trace" flag.
+  void InitTracer();
+
+  /// @brief Writes any remaining events and closes the trace file.
+  void CleanUpTracer();
+
+  /**
+   * @brief Adds an event to the calling thread's trace buffer, and writes the buffer to the trace file if it is full.
+   * 
+   * @param[in] name   The name of the zone.
+   * @param[in] detail Extra information about the zone, or an empty string if there is none.
+   * @param[in] start  The point in time that the zone was entered.
+   * @param[in] end    The point in time that the zone was left.
+   */
+  void AddTraceEvent(const char* name, const std::string& detail, const usertypes::TimePoint& start, const usertypes::TimePoint& end);
+
+  /**
+   * @brief Writes a string to the given stream as a JSON string, escaping any characters that aren't allowed in JSON strings.
+   * @details Control characters are written as unicode escapes, and any bytes that aren't valid UTF-8 are replaced with U+FFFD.
+   * @note The trace mutex must be locked when writing to the trace file.
+   * 
+   * @param[in,out] stream The stream to write to.
+   * @param[in]     text   The string to write.
+   */
+  void WriteTraceString(std::ostream& stream, const std::string& text);
+
+  /**
+   * @brief Returns the length of the multi-byte UTF-8 sequence starting at the given index.
+   * 
+   * @param[in] text  The string to check.
+   * @param[in] index The index of the sequence's lead byte.
+   * @returns The length of the sequence in bytes, or 0 if it isn't a valid UTF-8 sequence.
+   */
+  size_t GetUTF8SequenceLength(const std::string& text, size_t index);
+
+  /**
+   * @brief Writes the events in a trace buffer to the trace file, and clears the buffer.
+   * @note The trace mutex must be locked when calling this.
+   * 
+   * @param[in,out] buffer The trace buffer to write.
+   */
+  void WriteTraceBuffer(TraceBuffer& buffer);
+}
+
+#endif // ! TRACER_H
@@ -90,7 +90,7 @@ namespace term_engine::usertypes {
     }
   }
 
-  void Background::CopyToBuffer(rendering::Buffer& buffer) const
+  void Background::CopyToBuffer(rendering::BufferList& buffer) const
   {
     assert(image_ != nullptr);
 
@@ -100,9 +100,9 @@ namespace term_engine::usertypes {
     * | \
     * 3--2
     */
-    buffer.data.push_back(rendering::BufferData(glm::vec2(position_), glm::vec2(), colour_));
-    buffer.data.push_back(rendering::BufferData(glm::vec2(position_ + size_), glm::vec2(1.0f), colour_));
-    buffer.data.push_back(rendering::BufferData(glm::vec2(position_.x, position_.y + size_.y), glm::vec2(0.0f, 1.0f), colour_));
+    buffer.push_back(rendering::BufferData(glm::vec2(position_), glm::vec2(), colour_));
+    buffer.push_back(rendering::BufferData(glm::vec2(position_ + size_), glm::vec2(1.0f), colour_));
+    buffer.push_back(rendering::BufferData(glm::vec2(position_.x, position_.y + size_.y), glm::vec2(0.0f, 1.0f), colour_));
 
     /* Draw order:
     * 1--2
@@ -110,9 +110,9 @@ namespace term_engine::usertypes {
     *   \|
     *    3
     */
-    buffer.data.push_back(rendering::BufferData(glm::vec2(position_), glm::vec2(), colour_));
-    buffer.data.push_back(rendering::BufferData(glm::vec2(position_.x + size_.x, position_.y), glm::vec2(1.0f, 0.0f), colour_));
-    buffer.data.push_back(rendering::BufferData(glm::vec2(position_ + size_), glm::vec2(1.0f), colour_));
+    buffer.push_back(rendering::BufferData(glm::vec2(position_), glm::vec2(), colour_));
+    buffer.push_back(rendering::BufferData(glm::vec2(position_.x + size_.x, position_.y), glm::vec2(1.0f, 0.0f), colour_));
+    buffer.push_back(rendering::BufferData(glm::vec2(position_ + size_), glm::vec2(1.0f), colour_));
   }
 
   void Background::Use() const
@@ -122,6 +122,13 @@ namespace term_engine::usertypes {
     image_->Use();
   }
 
+  const rendering::TextureData& Background::GetTextureData() const
+  {
+    assert(image_ != nullptr);
+
+    return image_->GetTextureData();
+  }
+
   void Background::UpdateDebugInfo() const
   {
     ImGui::SeparatorText("Background");
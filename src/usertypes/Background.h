@@ -88,13 +88,20 @@ namespace term_engine::usertypes {
     /**
      * @brief Copys the background vertex data into a buffer.
      * 
-     * @param[in] buffer The buffer to copy data to.
+     * @param[in,out] buffer The buffer data to copy data to.
      */
-    void CopyToBuffer(rendering::Buffer& buffer) const;
+    void CopyToBuffer(rendering::BufferList& buffer) const;
 
     /// @brief Binds the background's texture ID to it's index.
     void Use() const;
 
+    /**
+     * @brief Returns the texture data of the background's image.
+     * 
+     * @returns The texture data.
+     */
+    const rendering::TextureData& GetTextureData() const;
+
     /// @brief Updates the debugging information for this resource.
     void UpdateDebugInfo() const;
 
@@ -3,22 +3,70 @@
 #include "CharacterMap.h"
 #include "../utility/ConversionUtils.h"
 #include "../utility/ImGuiUtils.h"
+#include "../utility/JobSystem.h"
 #include "../utility/LogUtils.h"
 
 namespace term_engine::usertypes {
+  std::atomic<uint64_t> CharacterMap::shared_bytes_ = 0;
+
   CharacterMap::CharacterMap() :
-    hide_empty_characters_(true)
+    hide_empty_characters_(true),
+    depth_test_(false),
+    data_(std::make_shared<CharacterData>()),
+    is_opacity_dirty_(true),
+    is_opaque_(false)
   {
     SetSize(DEFAULT_CHARACTER_MAP_SIZE);
   }
 
   CharacterMap::CharacterMap(const glm::ivec2& size, const sol::table& data) :
-    hide_empty_characters_(true)
+    hide_empty_characters_(true),
+    depth_test_(false),
+    data_(std::make_shared<CharacterData>()),
+    is_opacity_dirty_(true),
+    is_opaque_(false)
   {
     SetSize(size);
     SetData(data);
   }
 
+  CharacterMap::CharacterMap(const CharacterMap& character_map) :
+    size_(character_map.size_),
+    hide_empty_characters_(character_map.hide_empty_characters_),
+    depth_test_(character_map.depth_test_),
+    data_(character_map.data_),
+    depth_(character_map.depth_),
+    is_opacity_dirty_(character_map.is_opacity_dirty_),
+    is_opaque_(character_map.is_opaque_)
+  {
+    shared_bytes_ += GetDataBytes();
+  }
+
+  CharacterMap::~CharacterMap()
+  {
+    Release();
+  }
+
+  CharacterMap& CharacterMap::operator=(const CharacterMap& character_map)
+  {
+    if (data_ != character_map.data_)
+    {
+      Release();
+
+      data_ = character_map.data_;
+      shared_bytes_ += GetDataBytes();
+    }
+
+    size_ = character_map.size_;
+    hide_empty_characters_ = character_map.hide_empty_characters_;
+    depth_test_ = character_map.depth_test_;
+    depth_ = character_map.depth_;
+    is_opacity_dirty_ = character_map.is_opacity_dirty_;
+    is_opaque_ = character_map.is_opaque_;
+
+    return *this;
+  }
+
   glm::ivec2& CharacterMap::GetSize()
   {
     return size_;
@@ -26,7 +74,52 @@ namespace term_engine::usertypes {
 
   CharacterData& CharacterMap::GetData()
   {
-    return sol::as_container(data_);
+    Detach();
+
+    return sol::as_container(*data_);
+  }
+
+  bool CharacterMap::IsDepthTested() const
+  {
+    return depth_test_;
+  }
+
+  const Character& CharacterMap::GetCharacter(const glm::ivec2& rowcol) const
+  {
+    return data_->at(utility::GetIndexFromRowCol(size_, rowcol));
+  }
+
+  void CharacterMap::SetCharacter(const glm::ivec2& rowcol, const Character& character)
+  {
+    const size_t index = utility::GetIndexFromRowCol(size_, rowcol);
+
+    if (index >= data_->size())
+    {
+      utility::LogWarn("Position {}, {} is outside of the character map!", rowcol.x, rowcol.y);
+
+      return;
+    }
+
+    Detach();
+    (*data_)[index] = character;
+  }
+
+  bool CharacterMap::IsShared() const
+  {
+    return data_.use_count() > 1;
+  }
+
+  bool CharacterMap::IsOpaque() const
+  {
+    if (is_opacity_dirty_)
+    {
+      is_opaque_ = !hide_empty_characters_ || std::none_of(data_->begin(), data_->end(), [](const Character& character) {
+        return character.character_ == NO_CHARACTER;
+      });
+      is_opacity_dirty_ = false;
+    }
+
+    return is_opaque_;
   }
 
   bool& CharacterMap::AreEmptyCharactersHidden()
@@ -43,11 +136,16 @@ namespace term_engine::usertypes {
       return;
     }
 
+    // Allocate new data rather than resizing, so that any maps sharing the old data are left untouched.
     const uint64_t data_size = size.x * size.y;
-    data_.clear();
-    data_.reserve(data_size);
-    data_.resize(data_size);
-    data_.shrink_to_fit();
+    Release();
+    data_ = std::make_shared<CharacterData>(data_size);
+    is_opacity_dirty_ = true;
+
+    if (depth_test_)
+    {
+      depth_.assign(data_size, EMPTY_DEPTH);
+    }
 
     size_ = size;
   }
@@ -58,8 +156,10 @@ namespace term_engine::usertypes {
     {
       CharacterData characters = data.as<CharacterData>();
 
+      Detach();
+
       const int in_size = characters.size();
-      const int size = data_.size();
+      const int size = data_->size();
 
       if (in_size < size) {
         utility::LogDebug("Character data of smaller than character map. Old data will be blanked.");
@@ -76,7 +176,7 @@ namespace term_engine::usertypes {
           break;
         }
 
-        data_[i] = characters.at(i);
+        (*data_)[i] = characters.at(i);
       }
     }
     catch (const std::exception& err)
@@ -88,55 +188,114 @@ namespace term_engine::usertypes {
   void CharacterMap::SetHideEmptyCharacters(bool flag)
   {
     hide_empty_characters_ = flag;
+    is_opacity_dirty_ = true;
+  }
+
+  void CharacterMap::SetDepthTest(bool flag)
+  {
+    depth_test_ = flag;
+
+    if (depth_test_)
+    {
+      depth_.assign(data_->size(), EMPTY_DEPTH);
+    }
+    else
+    {
+      depth_.clear();
+      depth_.shrink_to_fit();
+    }
   }
 
   void CharacterMap::Clear()
   {
-    std::fill(data_.begin(), data_.end(), Character());
+    std::fill(depth_.begin(), depth_.end(), EMPTY_DEPTH);
+    is_opacity_dirty_ = true;
+
+    if (IsShared())
+    {
+      // No need to copy data that is about to be blanked.
+      const uint64_t data_size = data_->size();
+      Release();
+      data_ = std::make_shared<CharacterData>(data_size);
+    }
+    else
+    {
+      std::fill(data_->begin(), data_->end(), Character());
+    }
   }
 
   void CharacterMap::SetFunction(const sol::function& func)
   {
     int index = 1;
 
-    for (Character& character : data_)
+    Detach();
+
+    for (Character& character : *data_)
     {
-      character = func.call<Character>(data_, index++);
+      character = func.call<Character>(*data_, index++);
     }
   }
 
   void CharacterMap::PushCharacters(const glm::ivec2& position, const CharacterMap& data)
   {
-    // Do not push the character map if it is outside the target character map.
-    // I.e. If the top-left corner of the source character map is beyond the right/bottom edges of the target character map,
-    // or if the bottom-right corner of the source character map is beyond the top/left edges of the target character map.
-    if (glm::any(glm::lessThan(position + data.size_, glm::ivec2(0))) || glm::any(glm::greaterThanEqual(position, size_)))
+    Detach();
+    PushCharactersAt(position, data, EMPTY_DEPTH, false, 0, size_.y);
+  }
+
+  void CharacterMap::PushCharacters(const glm::ivec2& position, const CharacterMap& data, int64_t depth)
+  {
+    Detach();
+    PushCharactersAt(position, data, depth, depth_test_, 0, size_.y);
+  }
+
+  void CharacterMap::PushDrawList(const CharacterMapDrawList& draw_list)
+  {
+    if (draw_list.empty())
     {
       return;
     }
 
-    uint64_t column_pos = 0;
-    uint64_t index = utility::GetIndexFromRowCol(size_, position);
+    // Copy shared data before the workers start, as each of them writes to it.
+    Detach();
+
+    // Each worker only writes to its own rows, so the workers never write to the same characters.
+    utility::ParallelFor(size_.y, utility::ROW_JOB_BATCH_SIZE, [this, &draw_list](size_t first_row, size_t last_row) {
+      for (const CharacterMapDrawCommand& command : draw_list)
+      {
+        PushCharactersAt(command.position_, *command.data_, command.depth_, depth_test_, (int)first_row, (int)last_row);
+      }
+    });
+  }
+
+  void CharacterMap::PushCharactersAt(const glm::ivec2& position, const CharacterMap& data, int64_t depth, bool depth_test, int first_row, int last_row)
+  {
+    // Only push the part of the source character map that lies within the target character map, and within the given rows.
+    const int first_data_row = std::max(first_row - position.y, 0);
+    const int last_data_row = std::min(last_row - position.y, data.size_.y);
+    const int first_data_column = std::max(-position.x, 0);
+    const int last_data_column = std::min(size_.x - position.x, data.size_.x);
 
-    for (const Character& character : data.data_)
+    for (int row = first_data_row; row < last_data_row; ++row)
     {
-      bool omitEmptyChars = (character.character_ == NO_CHARACTER && data.hide_empty_characters_);
+      uint64_t data_index = (uint64_t)row * data.size_.x + first_data_column;
+      uint64_t index = (uint64_t)(position.y + row) * size_.x + position.x + first_data_column;
+
+      for (int column = first_data_column; column < last_data_column; ++column, ++data_index, ++index)
+      {
+        const Character& character = (*data.data_)[data_index];
 
-      // Do not push the character if it is an empty character.
-      if (!omitEmptyChars && (position.x + (int64_t)column_pos) >= 0 && (position.x + (int64_t)column_pos) < size_.x) {
-        // Do not push the character if it is outside the target character map.
-        if ((int64_t)index >= 0 && index < data_.size()) {
-          data_.at(index) = Character(character);
+        // Do not push the character if it is an empty character, or beneath a character pushed at a higher depth.
+        if ((character.character_ == NO_CHARACTER && data.hide_empty_characters_) || (depth_test && depth < depth_[index]))
+        {
+          continue;
         }
-      }
 
-      ++column_pos;
-      ++index;
+        (*data_)[index] = character;
 
-      if ((int64_t)column_pos == data.size_.x)
-      {
-        index += size_.x - column_pos;
-        column_pos = 0;
+        if (depth_test)
+        {
+          depth_[index] = depth;
+        }
       }
     }
   }
@@ -147,21 +306,54 @@ namespace term_engine::usertypes {
     {
       ImGui::Text("Size: %i, %i", size_.x, size_.y);
       ImGui::Text("Hide empty characters?: %s", hide_empty_characters_ ? "Yes" : "No");
+      ImGui::Text("Depth tested?: %s", depth_test_ ? "Yes" : "No");
+      ImGui::Text("Shared with: %li other map(s)", data_.use_count() - 1);
       ImGui::SeparatorText("First Char");
-      ImGui::Text("Value: %i", data_.at(0).character_);
-      ImGui::Text("Hidden?: %s", data_.at(0).character_ == NO_CHARACTER && hide_empty_characters_ ? "Yes" : "No");
+      ImGui::Text("Value: %i", data_->at(0).character_);
+      ImGui::Text("Hidden?: %s", data_->at(0).character_ == NO_CHARACTER && hide_empty_characters_ ? "Yes" : "No");
 
-      UpdateCharacterDataDebugInfo(data_, size_);
+      UpdateCharacterDataDebugInfo(*data_, size_);
       
       ImGui::TreePop();
     }
   }
 
-  void CharacterMap::CopyToBuffer(CharacterMap* character_map, const glm::ivec2& position, rendering::Buffer& buffer, Font* font_, uint32_t font_size)
+  uint64_t CharacterMap::GetSharedBytes()
+  {
+    return shared_bytes_;
+  }
+
+  uint64_t CharacterMap::GetDataBytes() const
+  {
+    return data_ ? data_->size() * sizeof(Character) : 0;
+  }
+
+  void CharacterMap::Detach()
+  {
+    is_opacity_dirty_ = true;
+
+    if (IsShared())
+    {
+      shared_bytes_ -= GetDataBytes();
+      data_ = std::make_shared<CharacterData>(*data_);
+    }
+  }
+
+  void CharacterMap::Release()
+  {
+    if (IsShared())
+    {
+      shared_bytes_ -= GetDataBytes();
+    }
+
+    data_.reset();
+  }
+
+  void CharacterMap::CopyToBuffer(CharacterMap* character_map, const glm::ivec2& position, rendering::BufferList& buffer, Font* font_, uint32_t font_size)
   {
     uint64_t index = 0;
 
-    for (const Character& character : character_map->data_)
+    for (const Character& character : *character_map->data_)
     {
       const CharacterBB textBbox = font_->GetCharacter(character.character_, font_size);
       const glm::vec2 charSize = glm::vec2(font_->GetCharacterSize(font_size));
@@ -179,9 +371,9 @@ namespace term_engine::usertypes {
        * | \
        * 3--2
        */
-      buffer.data.push_back(rendering::BufferData(charOffset, glm::vec2(), bgColour));
-      buffer.data.push_back(rendering::BufferData(charOffset + charSize, bgTexSize, bgColour));
-      buffer.data.push_back(rendering::BufferData(charOffset + glm::vec2(0.0f, charSize.y), glm::vec2(0.0f, bgTexSize.y), bgColour));
+      buffer.push_back(rendering::BufferData(charOffset, glm::vec2(), bgColour));
+      buffer.push_back(rendering::BufferData(charOffset + charSize, bgTexSize, bgColour));
+      buffer.push_back(rendering::BufferData(charOffset + glm::vec2(0.0f, charSize.y), glm::vec2(0.0f, bgTexSize.y), bgColour));
 
       /* Draw order:
        * 1--2
@@ -189,9 +381,9 @@ namespace term_engine::usertypes {
        *   \|
        *    3
        */
-      buffer.data.push_back(rendering::BufferData(charOffset, glm::vec2(), bgColour));
-      buffer.data.push_back(rendering::BufferData(charOffset + glm::vec2(charSize.x, 0), glm::vec2(bgTexSize.x, 0.0f), bgColour));
-      buffer.data.push_back(rendering::BufferData(charOffset + charSize, bgTexSize, bgColour));
+      buffer.push_back(rendering::BufferData(charOffset, glm::vec2(), bgColour));
+      buffer.push_back(rendering::BufferData(charOffset + glm::vec2(charSize.x, 0), glm::vec2(bgTexSize.x, 0.0f), bgColour));
+      buffer.push_back(rendering::BufferData(charOffset + charSize, bgTexSize, bgColour));
 
       // Draw the foreground.
       /* Draw order:
@@ -200,9 +392,9 @@ namespace term_engine::usertypes {
        * | \
        * 3--2
        */
-      buffer.data.push_back(rendering::BufferData(charOffset + textOffset, textTexPos, character.foreground_colour_));
-      buffer.data.push_back(rendering::BufferData(charOffset + glm::vec2(textBbox.character_size_) + textOffset, textTexPos + textTexSize, character.foreground_colour_));
-      buffer.data.push_back(rendering::BufferData(charOffset + glm::vec2(0, textBbox.character_size_.y) + textOffset, glm::vec2(textTexPos.x, textTexPos.y + textTexSize.y), character.foreground_colour_));
+      buffer.push_back(rendering::BufferData(charOffset + textOffset, textTexPos, character.foreground_colour_));
+      buffer.push_back(rendering::BufferData(charOffset + glm::vec2(textBbox.character_size_) + textOffset, textTexPos + textTexSize, character.foreground_colour_));
+      buffer.push_back(rendering::BufferData(charOffset + glm::vec2(0, textBbox.character_size_.y) + textOffset, glm::vec2(textTexPos.x, textTexPos.y + textTexSize.y), character.foreground_colour_));
 
       /* Draw order:
        * 1--2
@@ -210,9 +402,9 @@ namespace term_engine::usertypes {
        *   \|
        *    3
        */
-      buffer.data.push_back(rendering::BufferData(charOffset + textOffset, textTexPos, character.foreground_colour_));
-      buffer.data.push_back(rendering::BufferData(charOffset + glm::vec2(textBbox.character_size_.x, 0) + textOffset, glm::vec2(textTexPos.x + textTexSize.x, textTexPos.y), character.foreground_colour_));
-      buffer.data.push_back(rendering::BufferData(charOffset + glm::vec2(textBbox.character_size_) + textOffset, textTexPos + textTexSize, character.foreground_colour_));
+      buffer.push_back(rendering::BufferData(charOffset + textOffset, textTexPos, character.foreground_colour_));
+      buffer.push_back(rendering::BufferData(charOffset + glm::vec2(textBbox.character_size_.x, 0) + textOffset, glm::vec2(textTexPos.x + textTexSize.x, textTexPos.y), character.foreground_colour_));
+      buffer.push_back(rendering::BufferData(charOffset + glm::vec2(textBbox.character_size_) + textOffset, textTexPos + textTexSize, character.foreground_colour_));
     }
   }
 }
@@ -3,6 +3,10 @@
 #ifndef CHARACTER_MAP_H
 #define CHARACTER_MAP_H
 
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
 #include "Character.h"
 #include "resources/Font.h"
 #include "../rendering/Buffer.h"
@@ -12,6 +16,25 @@
 namespace term_engine::usertypes {
   /// @brief The default number of rows/columns in the view.
   constexpr glm::ivec2 DEFAULT_CHARACTER_MAP_SIZE = glm::ivec2(32, 16);
+  /// @brief The depth of a cell that nothing has been pushed to yet.
+  constexpr int64_t EMPTY_DEPTH = std::numeric_limits<int64_t>::min();
+
+  class CharacterMap;
+
+  /// @brief Describes a character map to be pushed to another character map.
+  struct CharacterMapDrawCommand {
+    /// @brief The position on the target map to start pushing characters to, in rows/columns.
+    glm::ivec2 position_;
+    /// @brief A raw pointer to the character map to push.
+    const CharacterMap* data_;
+    /// @brief The depth to push the characters at.
+    int64_t depth_;
+  };
+
+  /// @brief Used to store the depth of each character in a character map.
+  typedef std::vector<int64_t> DepthData;
+  /// @brief Used to store a list of character maps to push to another character map, in the order they are pushed.
+  typedef std::vector<CharacterMapDrawCommand> CharacterMapDrawList;
 
   /// @brief Defines a map of characters to render to a game scene.
   class CharacterMap {
@@ -27,6 +50,25 @@ namespace term_engine::usertypes {
      */
     CharacterMap(const glm::ivec2& size, const sol::table& data);
 
+    /**
+     * @brief Copy-constructs the character map from an existing map.
+     * @details The character data is shared with the other map, until either map is modified.
+     * 
+     * @param[in] character_map The character map to copy from.
+     */
+    CharacterMap(const CharacterMap& character_map);
+
+    /// @brief Destroys the character map.
+    ~CharacterMap();
+
+    /**
+     * @brief Copies the given character map into this one, sharing its character data until either map is modified.
+     * 
+     * @param[in] character_map The character map to copy from.
+     * @returns A reference to this character map.
+     */
+    CharacterMap& operator=(const CharacterMap& character_map);
+
     /**
      * @brief Gets the size of the character map.
      * 
@@ -36,11 +78,43 @@ namespace term_engine::usertypes {
 
     /**
      * @brief Returns the list of characters in the map.
+     * @note As the data can be modified through the returned reference, this un-shares the data with other maps.
+     * @warning The reference is only un-shared when it is retrieved. If this map is copied afterwards, writes through the reference also change the copy, so Lua scripts should use GetCharacter() and SetCharacter() instead of holding onto it.
      * 
      * @returns The character data.
      */
     CharacterData& GetData();
 
+    /**
+     * @brief Returns if the character data is shared with other character maps.
+     * 
+     * @returns If the character data is shared.
+     */
+    bool IsShared() const;
+
+    /**
+     * @brief Returns the character at the given position, without un-sharing the character data.
+     * 
+     * @param[in] rowcol The position of the character, in rows/columns.
+     * @returns The character at the position.
+     */
+    const Character& GetCharacter(const glm::ivec2& rowcol) const;
+
+    /**
+     * @brief Sets the character at the given position, un-sharing the character data if needed.
+     * 
+     * @param[in] rowcol    The position of the character, in rows/columns.
+     * @param[in] character The character to set.
+     */
+    void SetCharacter(const glm::ivec2& rowcol, const Character& character);
+
+    /**
+     * @brief Returns if every character in the map is drawn when pushed to another map, fully covering what is beneath it.
+     * 
+     * @returns If the character map is opaque.
+     */
+    bool IsOpaque() const;
+
     /**
      * @brief Returns if background colour are omitted when rendering empty characters.
      * 
@@ -48,6 +122,13 @@ namespace term_engine::usertypes {
      */
     bool& AreEmptyCharactersHidden();
 
+    /**
+     * @brief Returns if characters are depth tested when pushed to the map.
+     * 
+     * @returns If characters are depth tested.
+     */
+    bool IsDepthTested() const;
+
     /**
      * @brief Sets the size of the character map, in rows/columns.
      * 
@@ -69,6 +150,14 @@ namespace term_engine::usertypes {
      */
     void SetHideEmptyCharacters(bool flag);
 
+    /**
+     * @brief Sets if characters are depth tested when pushed to the map.
+     * @details When enabled, the map keeps a depth for each cell, and characters are only overwritten by those pushed at the same or a higher depth.
+     * 
+     * @param[in] flag If characters should be depth tested.
+     */
+    void SetDepthTest(bool flag);
+
     /// @brief Clears the character map.
     void Clear();
 
@@ -88,7 +177,26 @@ namespace term_engine::usertypes {
     void PushCharacters(const glm::ivec2& position, const CharacterMap& data);
 
     /**
-     * @brief Copies the data from a character map into an OpenGL buffer.
+     * @brief Pushes character data to the buffer at the given index, at the given depth.
+     * @details If depth testing is enabled, characters pushed at a lower depth than what is already in the map are discarded. This allows character maps to be pushed in any order.
+     * 
+     * @param[in] position The position on the map to start pushing characters to, in rows/columns.
+     * @param[in] data     The character data to push.
+     * @param[in] depth    The depth to push the characters at.
+     */
+    void PushCharacters(const glm::ivec2& position, const CharacterMap& data, int64_t depth);
+
+    /**
+     * @brief Pushes each character map in the given list, in order.
+     * @details The rows of this map are split between the job system's workers, and each worker pushes the part of every character map in its rows, in list order.
+     *          This gives the same result as pushing the character maps one at a time.
+     * 
+     * @param[in] draw_list The list of character maps to push.
+     */
+    void PushDrawList(const CharacterMapDrawList& draw_list);
+
+    /**
+     * @brief Copies the data from a character map into buffer data, ready to be pushed to an OpenGL buffer.
      * 
      * @param[in] character_map 
      * @param[in] position
@@ -96,18 +204,64 @@ namespace term_engine::usertypes {
      * @param[in] font 
      * @param[in] font_size
      */
-    static void CopyToBuffer(CharacterMap* character_map, const glm::ivec2& position, rendering::Buffer& buffer, Font* font, uint32_t font_size);
+    static void CopyToBuffer(CharacterMap* character_map, const glm::ivec2& position, rendering::BufferList& buffer, Font* font, uint32_t font_size);
 
     /// @brief Updates the debugging information for this character map.
     void UpdateDebugInfo() const;
 
+    /**
+     * @brief Returns the amount of memory saved by sharing character data between maps.
+     * 
+     * @returns The amount of memory saved, in bytes.
+     */
+    static uint64_t GetSharedBytes();
+
   protected:
     /// @brief The size of the character map, in rows/columns.
     glm::ivec2 size_;
     /// @brief Should the background colour be omitted when rendering an empty character?
     bool hide_empty_characters_;
-    /// @brief The character data to be rendered to a game scene.
-    CharacterData data_;
+    /// @brief Are characters depth tested when pushed to the map?
+    bool depth_test_;
+    /// @brief The character data to be rendered to a game scene. This is shared between copies of the map, until one of them is modified.
+    std::shared_ptr<CharacterData> data_;
+    /// @brief The amount of memory saved by sharing character data between maps, in bytes.
+    static std::atomic<uint64_t> shared_bytes_;
+    /// @brief The depth of each character in the map, if depth testing is enabled.
+    DepthData depth_;
+    /// @brief Has the character data changed since the map's opacity was last checked?
+    mutable bool is_opacity_dirty_;
+    /// @brief Is every character in the map drawn when pushed to another map?
+    mutable bool is_opaque_;
+
+    /**
+     * @brief Returns the amount of memory used by the character data.
+     * 
+     * @returns The amount of memory used, in bytes.
+     */
+    uint64_t GetDataBytes() const;
+
+    /**
+     * @brief Copies the character data, if it is shared with other maps, so that it can be safely modified.
+     * @note This should be called before any changes are made to the character data.
+     */
+    void Detach();
+
+    /// @brief Gives up this map's hold on the character data.
+    void Release();
+
+    /**
+     * @brief Pushes character data to the buffer at the given index, only writing to the given range of rows.
+     * @note The character data must not be shared when this is called.
+     * 
+     * @param[in] position    The position on the map to start pushing characters to, in rows/columns.
+     * @param[in] data        The character data to push.
+     * @param[in] depth       The depth to push the characters at.
+     * @param[in] depth_test  Should the characters be depth tested?
+     * @param[in] first_row   The first row of this map that can be written to.
+     * @param[in] last_row    The row after the last row of this map that can be written to.
+     */
+    void PushCharactersAt(const glm::ivec2& position, const CharacterMap& data, int64_t depth, bool depth_test, int first_row, int last_row);
   };
 }
 
@@ -1,5 +1,6 @@
 #include "EventListener.h"
 #include "../scripting/ScriptingInterface.h"
+#include "../system/Tracer.h"
 #include "../utility/ImGuiUtils.h"
 #include "../utility/LogUtils.h"
 
@@ -32,6 +33,11 @@ namespace term_engine::usertypes {
     }
   }
 
+  void EventListener::Remove()
+  {
+    listener_list.remove_if([this](const EventListenerPtr& listener) { return listener.get() == this; });
+  }
+
   uint64_t EventListener::GetListenerId() const
   {
     return listener_id_;
@@ -63,6 +69,8 @@ namespace term_engine::usertypes {
     {
       return;
     }
+
+    system::TraceScope scope("EventListener::Trigger", type_);
     
     try {
       sol::protected_function_result result = callback_(this, data);
@@ -146,12 +154,4 @@ namespace term_engine::usertypes {
 
     utility::LogDebug("Cleared all event listeners from the list.");
   }
-
-  void ClearFlaggedEventListeners()
-  {
-    listener_list.remove_if([](const EventListenerPtr& listener)
-    {
-      return listener->FlaggedForRemoval();
-    });
-  }
-}
\ No newline at end of file
+}
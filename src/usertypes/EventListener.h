@@ -42,6 +42,9 @@ namespace term_engine::usertypes {
      */
     void DoEvents(const events::Event& event);
 
+    /// @brief Removes the event listener from the list, destroying it.
+    void Remove();
+
     /**
      * @brief Returns the listener ID.
      * 
@@ -135,9 +138,6 @@ namespace term_engine::usertypes {
 
   /// @brief Clears all listeners from the list.
   void ClearAllEventListeners();
-
-  /// @brief Clears all listeners that are flagged for removal from the list.
-  void ClearFlaggedEventListeners();
 }
 
 #endif // ! EVENT_LISTENER_H
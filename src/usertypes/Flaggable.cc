@@ -2,9 +2,20 @@
 
 namespace term_engine::usertypes {
   Flaggable::Flaggable() :
-    marked_for_removal_(false)
+    marked_for_removal_(false),
+    is_queued_(false),
+    queue_index_(0)
   {}
 
+  Flaggable::~Flaggable()
+  {
+    // Objects can be destroyed while they're queued, e.g. game objects in a game scene that is removed first.
+    if (is_queued_)
+    {
+      removal_queue[queue_index_] = nullptr;
+    }
+  }
+
   bool Flaggable::FlaggedForRemoval() const
   {
     return marked_for_removal_;
@@ -13,10 +24,42 @@ namespace term_engine::usertypes {
   void Flaggable::FlagForRemoval()
   {
     marked_for_removal_ = true;
+
+    if (!is_queued_)
+    {
+      is_queued_ = true;
+      queue_index_ = removal_queue.size();
+      removal_queue.push_back(this);
+    }
   }
 
   void Flaggable::UnflagForRemoval()
   {
+    // The object is left in the queue, and is skipped over when the queue is cleared.
     marked_for_removal_ = false;
   }
+
+  void ClearRemovalQueue()
+  {
+    // Removing an object can flag others, so the size of the queue is checked on each iteration.
+    for (size_t index = 0; index < removal_queue.size(); ++index)
+    {
+      Flaggable* object = removal_queue[index];
+
+      if (object == nullptr)
+      {
+        continue;
+      }
+
+      removal_queue[index] = nullptr;
+      object->is_queued_ = false;
+
+      if (object->marked_for_removal_)
+      {
+        object->Remove();
+      }
+    }
+
+    removal_queue.clear();
+  }
 }
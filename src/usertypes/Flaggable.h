@@ -2,12 +2,26 @@
 #ifndef FLAGGABLE_H
 #define FLAGGABLE_H
 
+#include <cstddef>
+#include <vector>
+
 namespace term_engine::usertypes {
+  class Flaggable;
+
+  /// @brief Used to store the objects that have been flagged for removal.
+  typedef std::vector<Flaggable*> RemovalQueue;
+
+  /// @brief The objects that have been flagged for removal since the queue was last processed.
+  inline RemovalQueue removal_queue;
+
   class Flaggable {
   public:
     /// @brief Constructs the flaggable object.
     Flaggable();
 
+    /// @brief Takes the object out of the removal queue, if it is waiting in it.
+    virtual ~Flaggable();
+
     /**
      * @brief Returns if the object is flagged to be removed.
      * 
@@ -15,16 +29,31 @@ namespace term_engine::usertypes {
      */
     bool FlaggedForRemoval() const;
 
-    /// @brief Flags the object to be removed.
+    /// @brief Flags the object to be removed, and adds it to the removal queue.
     void FlagForRemoval();
 
     /// @brief Unsets the removal flag from the object.
     void UnflagForRemoval();
 
+    /**
+     * @brief Removes the object from the list that owns it.
+     * @note The object may be destroyed by this, so it must not be used afterwards.
+     */
+    virtual void Remove() = 0;
+
   protected:
     /// @brief A flag to mark this object to be removed.
     bool marked_for_removal_;
+    /// @brief Is the object waiting in the removal queue?
+    bool is_queued_;
+    /// @brief The index of the object in the removal queue, if it is waiting in it.
+    size_t queue_index_;
+
+    friend void ClearRemovalQueue();
   };
+
+  /// @brief Removes each object in the removal queue that is still flagged for removal, and empties the queue.
+  void ClearRemovalQueue();
 }
 
 #endif // ! FLAGGABLE_H
@@ -1,8 +1,18 @@
+#include <algorithm>
+#include <cinttypes>
 #include "EventListener.h"
 #include "GameScene.h"
+#include "GameWindow.h"
 #include "game_objects/GameObject.h"
+#include "../events/InputManager.h"
+#include "../events/Listener.h"
+#include "../scripting/ScriptingInterface.h"
 #include "../system/FileFunctions.h"
+#include "../system/FPSManager.h"
+#include "../system/Tracer.h"
+#include "../utility/ConversionUtils.h"
 #include "../utility/ImGuiUtils.h"
+#include "../utility/JobSystem.h"
 #include "../utility/LogUtils.h"
 
 namespace term_engine::usertypes {
@@ -11,15 +21,31 @@ namespace term_engine::usertypes {
     name_(name),
     character_map_(),
     game_window_(nullptr),
+    occlusion_culling_(false),
+    world_map_(nullptr),
+    game_objects_(),
+    draw_order_(),
+    draw_list_(),
+    spatial_grid_(),
+    hovered_object_id_(utility::NULL_SLOT_HANDLE),
+    collider_count_(0),
+    animating_count_(0),
+    overlapping_pairs_(),
+    collision_pairs_(),
     on_init_(sol::nil),
     on_loop_(sol::nil),
     on_quit_(sol::nil)
   {
+    character_map_.SetDepthTest(true);
+
     utility::LogDebug("Created game scene with name \"{}\".", name_);
   }
 
   GameScene::~GameScene()
   {
+    // Game objects remove themselves from the scene's draw order and spatial grid when destroyed, so destroy them while those still exist.
+    ClearGameObjects();
+
     on_init_ = sol::nil;
     on_loop_ = sol::nil;
     on_quit_ = sol::nil;
@@ -32,6 +58,14 @@ namespace term_engine::usertypes {
     return name_;
   }
 
+  void GameScene::Remove()
+  {
+    // The name is copied, as erasing the scene destroys the name it is keyed by.
+    const std::string name = name_;
+
+    game_scene_list.erase(name);
+  }
+
   CharacterMap* GameScene::GetCharacterMap()
   {
     return &character_map_;
@@ -42,6 +76,82 @@ namespace term_engine::usertypes {
     return game_window_;
   }
 
+  bool GameScene::IsOcclusionCulled() const
+  {
+    return occlusion_culling_;
+  }
+
+  WorldMap* GameScene::GetWorldMap()
+  {
+    return world_map_.get();
+  }
+
+  glm::ivec2 GameScene::GetCameraPosition() const
+  {
+    return world_map_ != nullptr ? world_map_->GetCameraPosition() : glm::ivec2(0);
+  }
+
+  GameObjectList& GameScene::GetGameObjects()
+  {
+    return game_objects_;
+  }
+
+  GameObjectDrawOrder& GameScene::GetDrawOrder()
+  {
+    return draw_order_;
+  }
+
+  SpatialGrid* GameScene::GetSpatialGrid()
+  {
+    return &spatial_grid_;
+  }
+
+  SpatialGridResult GameScene::GetObjectsAt(const glm::ivec2& rowcol)
+  {
+    SpatialGridResult result = spatial_grid_.GetObjectsAt(rowcol);
+    std::sort(result.begin(), result.end(), [](GameObject* lhs, GameObject* rhs) { return lhs->GetDepth() > rhs->GetDepth(); });
+
+    return result;
+  }
+
+  SpatialGridResult GameScene::GetObjectsInRect(const glm::ivec2& position, const glm::ivec2& size)
+  {
+    SpatialGridResult result = spatial_grid_.GetObjectsInRect(position, size);
+    std::sort(result.begin(), result.end(), [](GameObject* lhs, GameObject* rhs) { return lhs->GetDepth() > rhs->GetDepth(); });
+
+    return result;
+  }
+
+  GameObject* GameScene::AddGameObject(GameObjectPtr&& game_object)
+  {
+    game_object->SetSceneIndex(game_objects_.size());
+    game_objects_.push_back(std::move(game_object));
+
+    return game_objects_.back().get();
+  }
+
+  GameObjectPtr GameScene::ReleaseGameObject(GameObject* game_object)
+  {
+    const size_t index = game_object->GetSceneIndex();
+    GameObjectPtr released = std::move(game_objects_[index]);
+
+    // Move the last object into the released object's place, so that removal doesn't shift the rest of the list.
+    if (index != game_objects_.size() - 1)
+    {
+      game_objects_[index] = std::move(game_objects_.back());
+      game_objects_[index]->SetSceneIndex(index);
+    }
+
+    game_objects_.pop_back();
+
+    if (hovered_object_id_ == game_object->GetObjectId())
+    {
+      hovered_object_id_ = utility::NULL_SLOT_HANDLE;
+    }
+
+    return released;
+  }
+
   void GameScene::SetGameWindow(GameWindow* game_window)
   {
     if (game_window != nullptr)
@@ -55,6 +165,52 @@ namespace term_engine::usertypes {
     game_window_ = game_window;
   }
 
+  void GameScene::SetOcclusionCulling(bool flag)
+  {
+    occlusion_culling_ = flag;
+  }
+
+  WorldMap* GameScene::CreateWorldMap(const glm::ivec2& size)
+  {
+    if (size.x <= 0 || size.y <= 0)
+    {
+      utility::LogWarn("Cannot create world map with a width/height of 0!");
+
+      return nullptr;
+    }
+
+    world_map_ = std::make_unique<WorldMap>(size);
+
+    return world_map_.get();
+  }
+
+  WorldMap* GameScene::StreamWorldMap(const std::string& filename, const glm::ivec2& size)
+  {
+    if (filename.empty())
+    {
+      utility::LogWarn("No file has been selected to stream the world map from!");
+
+      return nullptr;
+    }
+    else if (size.x <= 0 || size.y <= 0)
+    {
+      utility::LogWarn("Cannot stream world map with a width/height of 0!");
+
+      return nullptr;
+    }
+
+    // Release the existing world map first, in case it is streamed from the same file.
+    world_map_.reset();
+    world_map_ = std::make_unique<WorldMap>(filename, size);
+
+    return world_map_.get();
+  }
+
+  void GameScene::RemoveWorldMap()
+  {
+    world_map_.reset();
+  }
+
   sol::function* GameScene::GetOnInit()
   {
     return &on_init_;
@@ -99,11 +255,13 @@ namespace term_engine::usertypes {
     return utility::CallWithResult(on_init_);
   }
 
-  void GameScene::CallLoop(float timestep)
+  void GameScene::CallLoop(uint64_t timestep)
   {
     if (on_loop_.valid())
     {
-      utility::CallWithTimestep(on_loop_, timestep);
+      system::TraceScope scope("GameScene::CallLoop", name_);
+
+      utility::CallWithTimestep(on_loop_, system::ConvertTimestep(timestep));
     }
   }
 
@@ -121,6 +279,225 @@ namespace term_engine::usertypes {
     }
   }
 
+  void GameScene::UpdateGameObjects(uint64_t timestep)
+  {
+    // Each object only updates its own animation state, so the objects can be split between the job system's workers.
+    utility::ParallelFor(game_objects_.size(), utility::OBJECT_JOB_BATCH_SIZE, [this, timestep](size_t begin, size_t end) {
+      for (size_t index = begin; index < end; ++index)
+      {
+        game_objects_[index]->Update(timestep);
+      }
+    });
+
+    collider_count_ = 0;
+    animating_count_ = 0;
+
+    // Objects are re-indexed after they have moved and animated, so that hovering and collisions are checked against where they are drawn.
+    for (GameObjectPtr& game_object : game_objects_)
+    {
+      game_object->UpdateIndex();
+
+      if (game_object->IsActive() && game_object->GetCollisionMode() != CollisionMode::NO_COLLISION)
+      {
+        ++collider_count_;
+      }
+
+      if (game_object->IsActive() && game_object->GetAnimation().HasAnimationsQueued() && game_object->GetAnimation().IsPlaying())
+      {
+        ++animating_count_;
+      }
+    }
+
+    UpdateHoveredObject();
+
+    // Pairs from the last frame still need "exit" events, even if there are no longer enough collidable objects to collide.
+    if (collider_count_ >= 2 || !collision_pairs_.empty())
+    {
+      UpdateCollisions();
+    }
+  }
+
+  size_t GameScene::GetAnimatingCount() const
+  {
+    return animating_count_;
+  }
+
+  void GameScene::UpdateHoveredObject()
+  {
+    GameObject* hovered_object = nullptr;
+
+    if (game_window_ != nullptr && game_window_->GetWindow()->IsInFocus())
+    {
+      // The mouse position is converted once for the whole scene, and only the objects in its grid cell are checked.
+      const glm::ivec2 mouse_rowcol = utility::GetRowColFromPosition(game_window_, events::GetMousePosition()) + GetCameraPosition();
+
+      for (GameObject* game_object : spatial_grid_.GetObjectsAt(mouse_rowcol))
+      {
+        if (game_object->IsActive() && (hovered_object == nullptr || game_object->GetDepth() > hovered_object->GetDepth()))
+        {
+          hovered_object = game_object;
+        }
+      }
+    }
+
+    GameObject** previous_object_ptr = game_object_ids.Get(hovered_object_id_);
+    GameObject* previous_object = previous_object_ptr != nullptr ? *previous_object_ptr : nullptr;
+
+    if (hovered_object != previous_object)
+    {
+      if (previous_object != nullptr)
+      {
+        previous_object->SetHovering(false);
+      }
+
+      if (hovered_object != nullptr)
+      {
+        hovered_object->SetHovering(true);
+      }
+
+      hovered_object_id_ = hovered_object != nullptr ? hovered_object->GetObjectId() : utility::NULL_SLOT_HANDLE;
+    }
+  }
+
+  void GameScene::UpdateCollisions()
+  {
+    CollisionPairList pairs;
+
+    overlapping_pairs_.clear();
+    spatial_grid_.GetOverlappingPairs([](GameObject* game_object) {
+      return game_object->IsActive() && game_object->GetCollisionMode() != CollisionMode::NO_COLLISION;
+    }, overlapping_pairs_);
+
+    for (auto& [ lhs, rhs ] : overlapping_pairs_)
+    {
+      if (lhs->CollidesWith(*rhs))
+      {
+        const uint64_t lhs_id = lhs->GetObjectId();
+        const uint64_t rhs_id = rhs->GetObjectId();
+
+        pairs.emplace_back(std::min(lhs_id, rhs_id), std::max(lhs_id, rhs_id));
+      }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    const auto send_event = [this](const std::pair<uint64_t, uint64_t>& pair, const char* type) {
+      events::event_list.emplace_back("object_collision", game_window_, scripting::lua_state->create_table_with(
+        "game_scene", name_,
+        "id", pair.first,
+        "other_id", pair.second,
+        "type", type
+      ));
+    };
+
+    // Both lists are sorted, so walk them together to find the pairs that are only in one of them.
+    CollisionPairList::const_iterator current = pairs.begin();
+    CollisionPairList::const_iterator previous = collision_pairs_.begin();
+
+    while (current != pairs.end() || previous != collision_pairs_.end())
+    {
+      if (previous == collision_pairs_.end() || (current != pairs.end() && *current < *previous))
+      {
+        send_event(*current++, "enter");
+      }
+      else if (current == pairs.end() || *previous < *current)
+      {
+        send_event(*previous++, "exit");
+      }
+      else
+      {
+        ++current;
+        ++previous;
+      }
+    }
+
+    collision_pairs_ = std::move(pairs);
+  }
+
+  void GameScene::CullGameObjects()
+  {
+    static SpatialGridResult occluders;
+
+    for (GameObjectPtr& game_object : game_objects_)
+    {
+      if (!game_object->IsActive())
+      {
+        continue;
+      }
+
+      bool is_culled = !game_object->IsInsideGameScene();
+
+      if (!is_culled && occlusion_culling_)
+      {
+        const glm::ivec2 position = game_object->GetDrawnPosition();
+        const glm::ivec2 size = game_object->GetDrawnCharacterMap().GetSize();
+
+        // An object can only be covered by objects that cover its top-left corner, so only those are found from the spatial grid.
+        occluders.clear();
+        spatial_grid_.GetObjectsAt(position, occluders);
+
+        for (GameObject* occluder : occluders)
+        {
+          // Objects are drawn in depth order, so only objects with a greater depth are drawn above.
+          if (occluder == game_object.get() || !occluder->IsActive() || occluder->GetDepth() <= game_object->GetDepth())
+          {
+            continue;
+          }
+
+          const glm::ivec2 occluder_position = occluder->GetDrawnPosition();
+          const glm::ivec2 occluder_size = occluder->GetDrawnCharacterMap().GetSize();
+
+          if (glm::all(glm::greaterThanEqual(position, occluder_position)) && glm::all(glm::lessThanEqual(position + size, occluder_position + occluder_size)) && occluder->GetDrawnCharacterMap().IsOpaque())
+          {
+            is_culled = true;
+
+            break;
+          }
+        }
+      }
+
+      game_object->SetCulled(is_culled);
+
+      if (is_culled)
+      {
+        ++objects_culled;
+      }
+      else
+      {
+        ++objects_drawn;
+      }
+    }
+  }
+
+  void GameScene::DrawWorldMap()
+  {
+    if (world_map_ != nullptr)
+    {
+      world_map_->Draw(&character_map_);
+    }
+  }
+
+  void GameScene::DrawGameObjects()
+  {
+    draw_list_.clear();
+
+    for (auto& [ _, game_object ] : draw_order_)
+    {
+      game_object->Draw(draw_list_);
+    }
+
+    // The draw list is in layer order, so the objects are composited the same way regardless of how the rows are split between workers.
+    character_map_.PushDrawList(draw_list_);
+  }
+
+  void GameScene::ClearGameObjects()
+  {
+    game_objects_.clear();
+    hovered_object_id_ = utility::NULL_SLOT_HANDLE;
+
+    utility::LogDebug("Cleared all game objects for game scene \"{}\".", name_);
+  }
+
   void GameScene::ClearMap()
   {
     character_map_.Clear();
@@ -131,9 +508,21 @@ namespace term_engine::usertypes {
     if (ImGui::TreeNode(name_.c_str()))
     {
       ImGui::Text("Name: %s", name_.c_str());
+      ImGui::Text("Occlusion Culling?: %s", occlusion_culling_ ? "Yes" : "No");
+      ImGui::Text("Game Objects: %zu", game_objects_.size());
+      ImGui::Text("Spatial Grid Cells: %zu", spatial_grid_.GetCellCount());
+      ImGui::Text("Hovered Object: %" PRIu64, hovered_object_id_);
+      ImGui::Text("Collidable Objects: %zu", collider_count_);
+      ImGui::Text("Colliding Pairs: %zu", collision_pairs_.size());
+      ImGui::Text("Animating Objects: %zu", animating_count_);
 
       character_map_.UpdateDebugInfo();
 
+      if (world_map_ != nullptr)
+      {
+        world_map_->UpdateDebugInfo();
+      }
+
       ImGui::TreePop();
     }
   }
@@ -167,19 +556,48 @@ namespace term_engine::usertypes {
     return nullptr;
   }
 
-  void ClearFlaggedGameScenes()
+  void UpdateGameScenes(uint64_t timestep)
   {
-    for (auto it = game_scene_list.cbegin(); it != game_scene_list.cend(); it++)
+    for (auto& [ _, game_scene ] : game_scene_list)
     {
-      if (it->second->FlaggedForRemoval())
+      if (game_scene->GetGameWindow() != nullptr)
       {
-        ClearGameObjectsByGameScene(it->first);
+        game_scene->UpdateGameObjects(timestep);
+      }
+    }
+  }
+
+  void DrawGameScenes()
+  {
+    objects_drawn = 0;
+    objects_culled = 0;
 
-        game_scene_list.erase(it);
+    for (auto& [ _, game_scene ] : game_scene_list)
+    {
+      if (game_scene->GetGameWindow() != nullptr)
+      {
+        game_scene->CullGameObjects();
+
+        // The world map is drawn first, so that game objects are drawn above it in scenes that aren't depth tested.
+        game_scene->DrawWorldMap();
+        game_scene->DrawGameObjects();
       }
     }
   }
 
+  bool HasAnimatingGameObjects()
+  {
+    for (auto& [ _, game_scene ] : game_scene_list)
+    {
+      if (game_scene->GetGameWindow() != nullptr && game_scene->GetAnimatingCount() > 0)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
   void ClearAllGameScenes()
   {
     game_scene_list.clear();
@@ -3,19 +3,32 @@
 #ifndef GAME_SCENE_H
 #define GAME_SCENE_H
 
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 #include "CharacterMap.h"
 #include "Flaggable.h"
+#include "SpatialGrid.h"
+#include "WorldMap.h"
 #include "../rendering/Buffer.h"
 #include "../utility/SolUtils.h"
 
 namespace term_engine::usertypes {
+  class GameObject;
   class GameScene;
   class GameWindow;
 
+  /// @brief Unique pointer to a game object.
+  typedef std::unique_ptr<GameObject> GameObjectPtr;
+  /// @brief Used to store the game objects that belong to a game scene.
+  typedef std::vector<GameObjectPtr> GameObjectList;
+  /// @brief Used to store game objects in the order they are drawn, keyed by their depth.
+  typedef std::map<int64_t, GameObject*> GameObjectDrawOrder;
+  /// @brief Used to store the IDs of each pair of colliding game objects, with the lower ID first.
+  typedef std::vector<std::pair<uint64_t, uint64_t>> CollisionPairList;
   /// @brief Unique pointer to a game scene.
   typedef std::unique_ptr<GameScene> GameScenePtr;
   /// @brief Used to store a list of game scenes.
@@ -39,7 +52,7 @@ namespace term_engine::usertypes {
      */
     GameScene(const std::string& name);
 
-    /// @brief Destroys the game scene.
+    /// @brief Destroys the game scene, and the game objects belonging to it.
     ~GameScene();
 
     /**
@@ -49,6 +62,9 @@ namespace term_engine::usertypes {
      */
     std::string GetName() const;
 
+    /// @brief Removes the game scene from the list, destroying it and the game objects belonging to it.
+    void Remove();
+
     /**
      * @brief Returns the character map so that objects can be drawn to it.
      * 
@@ -63,6 +79,83 @@ namespace term_engine::usertypes {
      */
     GameWindow* GetGameWindow();
 
+    /**
+     * @brief Returns if objects that are completely covered by opaque objects are culled from drawing.
+     * 
+     * @returns If occlusion culling is enabled.
+     */
+    bool IsOcclusionCulled() const;
+
+    /**
+     * @brief Returns the world map drawn beneath the game objects in this scene.
+     * 
+     * @returns A raw pointer to the world map, or a null pointer if the scene does not have one.
+     */
+    WorldMap* GetWorldMap();
+
+    /**
+     * @brief Returns the position of the world map's camera, which game objects are drawn relative to.
+     * 
+     * @returns The camera position, in rows/columns, or (0, 0) if the scene does not have a world map.
+     */
+    glm::ivec2 GetCameraPosition() const;
+
+    /**
+     * @brief Returns the list of game objects belonging to this scene.
+     * 
+     * @returns The list of game objects.
+     */
+    GameObjectList& GetGameObjects();
+
+    /**
+     * @brief Returns the game objects belonging to this scene, in the order they are drawn.
+     * @note Game objects add and remove themselves from this as they are created, destroyed and moved between layers, so it never needs sorting.
+     * 
+     * @returns The draw order of the game objects.
+     */
+    GameObjectDrawOrder& GetDrawOrder();
+
+    /**
+     * @brief Returns the spatial grid that indexes the area each game object in this scene covers.
+     * 
+     * @returns A raw pointer to the spatial grid.
+     */
+    SpatialGrid* GetSpatialGrid();
+
+    /**
+     * @brief Returns the game objects in this scene that cover the given position.
+     * @note Objects are indexed by where they were when created or last moved with _SetPosition_, or at the last update otherwise.
+     * 
+     * @param[in] rowcol The position to check, in rows/columns.
+     * @returns The list of game objects, with the top-most object first.
+     */
+    SpatialGridResult GetObjectsAt(const glm::ivec2& rowcol);
+
+    /**
+     * @brief Returns the game objects in this scene that overlap the given area.
+     * 
+     * @param[in] position The top-left position of the area, in rows/columns.
+     * @param[in] size     The size of the area, in rows/columns.
+     * @returns The list of game objects, with the top-most object first.
+     */
+    SpatialGridResult GetObjectsInRect(const glm::ivec2& position, const glm::ivec2& size);
+
+    /**
+     * @brief Gives ownership of a game object to this scene.
+     * 
+     * @param[in] game_object The game object to add.
+     * @returns A raw pointer to the game object.
+     */
+    GameObject* AddGameObject(GameObjectPtr&& game_object);
+
+    /**
+     * @brief Takes ownership of a game object away from this scene, e.g. to move it to another scene.
+     * 
+     * @param[in] game_object A raw pointer to the game object.
+     * @returns The game object.
+     */
+    GameObjectPtr ReleaseGameObject(GameObject* game_object);
+
     /**
      * @brief Sets the game window this scene draws to.
      * @note Use this function to update the game window as well.
@@ -79,6 +172,34 @@ namespace term_engine::usertypes {
      */
     void UpdateGameWindow(GameWindow* game_window);
 
+    /**
+     * @brief Sets if objects that are completely covered by opaque objects are culled from drawing.
+     * 
+     * @param[in] flag If occlusion culling is enabled.
+     */
+    void SetOcclusionCulling(bool flag);
+
+    /**
+     * @brief Creates a world map for this scene, replacing the existing one.
+     * @details Once a scene has a world map, game object positions are treated as positions in the world, and are drawn relative to the world map's camera.
+     * 
+     * @param[in] size The size of the world map, in rows/columns.
+     * @returns A raw pointer to the world map.
+     */
+    WorldMap* CreateWorldMap(const glm::ivec2& size);
+
+    /**
+     * @brief Creates a world map for this scene that streams its chunks to and from a file, replacing the existing one.
+     * 
+     * @param[in] filename The path to the world map file, relative to the project folder. The file is created if it does not exist.
+     * @param[in] size     The size of the world map, in rows/columns. If the file already exists, the size stored in the file is used instead.
+     * @returns A raw pointer to the world map.
+     */
+    WorldMap* StreamWorldMap(const std::string& filename, const glm::ivec2& size);
+
+    /// @brief Removes the world map from this scene.
+    void RemoveWorldMap();
+
     /**
      * @brief Returns the Lua function that is called when the scene is loaded.
      * 
@@ -131,13 +252,51 @@ namespace term_engine::usertypes {
     /**
      * @brief Calls the Lua function for when the scene is updated, if set.
      * 
-     * @param[in] timestep The time since the last frame was run.
+     * @param[in] timestep The time since the last frame was run, in nanoseconds (ns).
      */
-    void CallLoop(float timestep);
+    void CallLoop(uint64_t timestep);
 
     /// @brief Calls the Lua function for when the scene is unloaded, if set.
     void CallQuit();
 
+    /**
+     * @brief Updates each game object in this scene, and then finds which object the mouse is hovering over and which objects are colliding.
+     * 
+     * @param[in] timestep The time since the last update, in nanoseconds (ns).
+     */
+    void UpdateGameObjects(uint64_t timestep);
+
+    /**
+     * @brief Returns the number of active game objects with an animation playing, found when the objects were last updated.
+     * 
+     * @returns The number of animating game objects.
+     */
+    size_t GetAnimatingCount() const;
+
+    /// @brief Finds the top-most active game object under the mouse cursor, and sends hover events if it has changed.
+    void UpdateHoveredObject();
+
+    /**
+     * @brief Finds which collidable game objects are colliding, and sends "object_collision" events for the pairs that started or stopped colliding since the last frame.
+     * @details The spatial grid is used to find the pairs of objects that overlap, and then objects that collide by cell are checked for non-empty characters in the overlapping area.
+     */
+    void UpdateCollisions();
+
+    /**
+     * @brief Culls game objects in this scene that do not need to be drawn this frame.
+     * @details Objects are culled if they lie outside of the scene's character map, or if occlusion culling is enabled and they are completely covered by an opaque object above them. The objects that could cover each object are found with the spatial grid.
+     */
+    void CullGameObjects();
+
+    /// @brief Draws the part of the world map under its camera to the scene, if the scene has one.
+    void DrawWorldMap();
+
+    /// @brief Draws each game object in this scene that hasn't been culled, in layer order.
+    void DrawGameObjects();
+
+    /// @brief Removes all game objects from this scene.
+    void ClearGameObjects();
+
     /// @brief Clears all character data from the scene.
     void ClearMap();
 
@@ -151,6 +310,28 @@ namespace term_engine::usertypes {
     CharacterMap character_map_;
     /// @brief A raw pointer to the game window this scene is drawing to.
     GameWindow* game_window_;
+    /// @brief Are objects that are completely covered by opaque objects culled from drawing?
+    bool occlusion_culling_;
+    /// @brief The world map drawn beneath the game objects in this scene.
+    WorldMapPtr world_map_;
+    /// @brief The game objects belonging to this scene.
+    GameObjectList game_objects_;
+    /// @brief The game objects belonging to this scene, in the order they are drawn.
+    GameObjectDrawOrder draw_order_;
+    /// @brief The character maps of the game objects to draw this frame, in layer order.
+    CharacterMapDrawList draw_list_;
+    /// @brief Indexes the area each game object in this scene covers.
+    SpatialGrid spatial_grid_;
+    /// @brief The ID of the game object the mouse is hovering over.
+    uint64_t hovered_object_id_;
+    /// @brief The number of active, collidable game objects found when the objects were last updated.
+    size_t collider_count_;
+    /// @brief The number of active game objects with an animation playing, found when the objects were last updated.
+    size_t animating_count_;
+    /// @brief The pairs of game objects whose areas overlapped this frame.
+    SpatialGridPairList overlapping_pairs_;
+    /// @brief The pairs of game objects that were colliding at the end of the last frame, sorted by ID.
+    CollisionPairList collision_pairs_;
     /// @brief The Lua function to call when this scene is loaded.
     sol::function on_init_;
     /// @brief The Lua function to call every frame the scene is active.
@@ -175,8 +356,23 @@ namespace term_engine::usertypes {
    */
   GameScene* GetGameSceneByName(const std::string& name);
 
-  /// @brief Clears all game scenes that are flagged for removal from the list.
-  void ClearFlaggedGameScenes();
+  /**
+   * @brief Updates the game objects of each game scene that is drawing to a game window.
+   * @note Game scenes that aren't drawing to a game window are skipped, leaving their game objects as they are.
+   * 
+   * @param[in] timestep The time since the last update, in nanoseconds (ns).
+   */
+  void UpdateGameScenes(uint64_t timestep);
+
+  /// @brief Culls and draws the world map and game objects of each game scene that is drawing to a game window.
+  void DrawGameScenes();
+
+  /**
+   * @brief Checks if any game scene that is drawing to a game window has game objects with animations playing.
+   * 
+   * @returns If any game objects are animating.
+   */
+  bool HasAnimatingGameObjects();
 
   /// @brief Clears all game scenes from the list.
   void ClearAllGameScenes();
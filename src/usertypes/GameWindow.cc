@@ -1,4 +1,6 @@
 #include "GameWindow.h"
+#include "../rendering/RenderThread.h"
+#include "../system/Profiler.h"
 #include "../utility/ImGuiUtils.h"
 
 namespace term_engine::usertypes {
@@ -9,8 +11,6 @@ namespace term_engine::usertypes {
     is_default_window_(is_default),
     font_(nullptr),
     font_size_(DEFAULT_FONT_SIZE),
-    text_buffer_(),
-    background_buffer_(),
     is_closing_(false)
   {
     font_ = LoadFont(std::string(DEFAULT_FONT));
@@ -63,6 +63,19 @@ namespace term_engine::usertypes {
     utility::LogDebug("Destroyed game window.");
   }
 
+  void GameWindow::Remove()
+  {
+    // The window may still be in use by the frame being drawn.
+    rendering::WaitForRenderThread();
+
+    game_window_list.remove_if([this](const GameWindowPtr& game_window) { return game_window.get() == this; });
+
+    if (game_window_list.empty())
+    {
+      GameWindow::Quit();
+    }
+  }
+
   GameScene* GameWindow::GetGameScene()
   {
     return game_scene_;
@@ -249,7 +262,15 @@ namespace term_engine::usertypes {
     SetGameScene(game_scene_);
   }
 
-  void GameWindow::Update(float timestep)
+  void GameWindow::Update(uint64_t timestep)
+  {
+    if (game_scene_ != nullptr)
+    {
+      game_scene_->CallLoop(timestep);
+    }
+  }
+
+  bool GameWindow::BuildFramePacket(rendering::FramePacket& packet)
   {
     if (font_->FlaggedForRemoval())
     {
@@ -268,42 +289,46 @@ namespace term_engine::usertypes {
 
     if (game_scene_ == nullptr)
     {
-      return;
+      return false;
     }
 
-    game_scene_->CallLoop(timestep);
-
-    window_->Use();
-    window_->Clear();
+    const glm::ivec2 size = window_->GetSize();
 
-    glm::ivec2 size = window_->GetSize();
-    glViewport(0, 0, size.x, size.y);
+    packet.window_ = window_->GetWindow();
+    packet.window_id_ = window_->GetId();
+    packet.size_ = size;
+    packet.clear_colour_ = window_->GetClearColour();
+    packet.render_mode_ = window_->IsWireframeEnabled() ? GL_LINE : GL_FILL;
+    packet.vsync_flag_ = Window::GetVsyncFlag();
+    packet.projection_ = glm::ortho(0.0f, (float)size.x, (float)size.y, 0.0f);
+    packet.has_background_ = background_.IsLoaded();
+    packet.background_data_.clear();
 
-    if (background_.IsLoaded())
+    if (packet.has_background_)
     {
-      background_buffer_.data.clear();
-      background_.CopyToBuffer(background_buffer_);
-      background_buffer_.PushToGL();
-      background_buffer_.Use();
-      background_.Use();
-      background_shader_program_->Use();
-
-      glDrawArrays(GL_TRIANGLES, 0, background_buffer_.data.size());
+      background_.CopyToBuffer(packet.background_data_);
+      packet.background_texture_ = background_.GetTextureData();
+      packet.background_program_id_ = background_shader_program_->GetProgramId();
     }
 
-    text_buffer_.data.clear();
-    CharacterMap::CopyToBuffer(game_scene_->GetCharacterMap(), glm::ivec2(0), text_buffer_, font_, font_size_);
+    packet.text_data_.clear();
+    CharacterMap::CopyToBuffer(game_scene_->GetCharacterMap(), glm::ivec2(0), packet.text_data_, font_, font_size_);
 
-    text_buffer_.PushToGL();
-    text_buffer_.Use();
-    font_->Use();
-    font_->UpdateTexture();
-    text_shader_program_->Use();
+    // Characters added to the font atlas while copying are uploaded here, as the font's texture is only changed on the main thread.
+    // The render thread may still be drawing the last frame with the texture, so it has to finish first. New characters are rare, so this seldom waits.
+    if (font_->IsTextureDirty())
+    {
+      rendering::WaitForRenderThread();
+      font_->Use();
+      font_->UpdateTexture();
+    }
 
-    glDrawArrays(GL_TRIANGLES, 0, text_buffer_.data.size());
+    packet.font_texture_ = font_->GetTextureData();
+    packet.text_program_id_ = text_shader_program_->GetProgramId();
 
-    window_->Refresh();
     game_scene_->ClearMap();
+
+    return true;
   }
 
   bool GameWindow::IsClosing() const
@@ -449,7 +474,7 @@ namespace term_engine::usertypes {
     }
   }
 
-  void UpdateGameWindows(float timestep)
+  void UpdateGameWindows(uint64_t timestep)
   {
     for (const GameWindowPtr& game_window : game_window_list)
     {
@@ -457,17 +482,31 @@ namespace term_engine::usertypes {
     }
   }
 
-  void ClearFlaggedGameWindows()
+  void RenderGameWindows()
   {
-    game_window_list.remove_if([](const GameWindowPtr& game_window)
-    {
-      return game_window->FlaggedForRemoval();
-    });
+    rendering::FramePacketList& packets = rendering::GetFramePackets();
 
-    if (game_window_list.empty())
     {
-      GameWindow::Quit();
+      system::ProfileScope scope(system::ProfileZone::VERTEX_BUILD);
+      size_t packet_count = 0;
+
+      for (const GameWindowPtr& game_window : game_window_list)
+      {
+        if (packet_count == packets.size())
+        {
+          packets.emplace_back();
+        }
+
+        if (game_window->BuildFramePacket(packets[packet_count]))
+        {
+          ++packet_count;
+        }
+      }
+
+      packets.resize(packet_count);
     }
+
+    rendering::SubmitFrame();
   }
 
   void ClearAllGameWindows()
@@ -11,7 +11,7 @@
 #include "Window.h"
 #include "resources/Font.h"
 #include "resources/ShaderProgram.h"
-#include "../rendering/Buffer.h"
+#include "../rendering/FramePacket.h"
 #include "../utility/SDLUtils.h"
 
 namespace term_engine::usertypes {
@@ -47,10 +47,6 @@ namespace term_engine::usertypes {
     ShaderProgram* background_shader_program_;
     /// @brief The shader program used to render characters to the game scene.
     ShaderProgram* text_shader_program_;
-    /// @brief Buffer to store the background vertices.
-    rendering::Buffer background_buffer_;
-    /// @brief Buffer to store the character vertices.
-    rendering::Buffer text_buffer_;
     /// @brief The font size to render characters at, in pixels (px).
     uint32_t font_size_;
     /// @brief Flag to check if the window is closing.
@@ -71,6 +67,9 @@ namespace term_engine::usertypes {
     /// @brief Destroys the game window.
     ~GameWindow();
 
+    /// @brief Removes the game window from the list, destroying it. If it was the last game window, the game quits.
+    void Remove();
+
     /**
      * @brief Returns the game scene being rendered to the window.
      * 
@@ -173,11 +172,20 @@ namespace term_engine::usertypes {
     void ReloadGameScene();
 
     /**
-     * @brief Updates the game scene (if set) and draws the character/background data to the window.
+     * @brief Updates the game scene, if set.
+     * 
+     * @param[in] timestep The time since the last update, in nanoseconds (ns).
+     */
+    void Update(uint64_t timestep);
+
+    /**
+     * @brief Builds the frame packet used to draw the character/background data of the game scene (if set) to the window.
+     * @details The character map is copied into the packet, and then cleared ready for the next frame.
      * 
-     * @param[in] timestep The time since the last frame was run.
+     * @param[out] packet The frame packet to build.
+     * @returns If there is a frame to draw, i.e. if a game scene is set.
      */
-    void Update(float timestep);
+    bool BuildFramePacket(rendering::FramePacket& packet);
 
     /**
      * @brief Returns if the window is closing.
@@ -247,14 +255,14 @@ namespace term_engine::usertypes {
   void DoGameWindowEvents(const SDL_Event& event);
 
   /**
-   * @brief Updates each game window.
+   * @brief Updates the game scene of each game window.
    * 
-   * @param[in] timestep The time since the last frame was run.
+   * @param[in] timestep The time since the last update, in nanoseconds (ns).
    */
-  void UpdateGameWindows(float timestep);
+  void UpdateGameWindows(uint64_t timestep);
 
-  /// @brief Clears all game windows that are flagged for removal from the list.
-  void ClearFlaggedGameWindows();
+  /// @brief Builds a frame packet for each game window, and submits them to be drawn.
+  void RenderGameWindows();
 
   /// @brief Clears all game windows from the list.
   void ClearAllGameWindows();
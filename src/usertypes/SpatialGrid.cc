@@ -0,0 +1,185 @@
+#include <algorithm>
+#include "SpatialGrid.h"
+
+namespace term_engine::usertypes {
+  SpatialGrid::SpatialGrid() :
+    cells_()
+  {}
+
+  void SpatialGrid::Insert(GameObject* object, const glm::ivec2& position, const glm::ivec2& size)
+  {
+    const glm::ivec2 first_cell = GetCellPosition(position);
+    const glm::ivec2 last_cell = GetCellPosition(position + glm::max(size, glm::ivec2(1)) - glm::ivec2(1));
+
+    for (int y = first_cell.y; y <= last_cell.y; ++y)
+    {
+      for (int x = first_cell.x; x <= last_cell.x; ++x)
+      {
+        cells_[GetCellKey(glm::ivec2(x, y))].push_back({ object, position, size });
+      }
+    }
+  }
+
+  void SpatialGrid::Remove(GameObject* object, const glm::ivec2& position, const glm::ivec2& size)
+  {
+    const glm::ivec2 first_cell = GetCellPosition(position);
+    const glm::ivec2 last_cell = GetCellPosition(position + glm::max(size, glm::ivec2(1)) - glm::ivec2(1));
+
+    for (int y = first_cell.y; y <= last_cell.y; ++y)
+    {
+      for (int x = first_cell.x; x <= last_cell.x; ++x)
+      {
+        SpatialGridCellList::iterator it = cells_.find(GetCellKey(glm::ivec2(x, y)));
+
+        if (it == cells_.end())
+        {
+          continue;
+        }
+
+        SpatialGridCell& cell = it->second;
+        SpatialGridCell::iterator entry = std::find_if(cell.begin(), cell.end(), [&object](const SpatialGridEntry& entry) { return entry.object_ == object; });
+
+        if (entry != cell.end())
+        {
+          *entry = cell.back();
+          cell.pop_back();
+        }
+
+        if (cell.empty())
+        {
+          cells_.erase(it);
+        }
+      }
+    }
+  }
+
+  SpatialGridResult SpatialGrid::GetObjectsAt(const glm::ivec2& rowcol) const
+  {
+    SpatialGridResult result;
+    GetObjectsAt(rowcol, result);
+
+    return result;
+  }
+
+  void SpatialGrid::GetObjectsAt(const glm::ivec2& rowcol, SpatialGridResult& result) const
+  {
+    SpatialGridCellList::const_iterator it = cells_.find(GetCellKey(GetCellPosition(rowcol)));
+
+    if (it != cells_.end())
+    {
+      for (const SpatialGridEntry& entry : it->second)
+      {
+        if (glm::all(glm::greaterThanEqual(rowcol, entry.position_)) && glm::all(glm::lessThan(rowcol, entry.position_ + entry.size_)))
+        {
+          result.push_back(entry.object_);
+        }
+      }
+    }
+  }
+
+  SpatialGridResult SpatialGrid::GetObjectsInRect(const glm::ivec2& position, const glm::ivec2& size) const
+  {
+    SpatialGridResult result;
+
+    if (size.x <= 0 || size.y <= 0)
+    {
+      return result;
+    }
+
+    const glm::ivec2 first_cell = GetCellPosition(position);
+    const glm::ivec2 last_cell = GetCellPosition(position + size - glm::ivec2(1));
+
+    for (int y = first_cell.y; y <= last_cell.y; ++y)
+    {
+      for (int x = first_cell.x; x <= last_cell.x; ++x)
+      {
+        SpatialGridCellList::const_iterator it = cells_.find(GetCellKey(glm::ivec2(x, y)));
+
+        if (it == cells_.end())
+        {
+          continue;
+        }
+
+        for (const SpatialGridEntry& entry : it->second)
+        {
+          if (glm::all(glm::lessThan(position, entry.position_ + entry.size_)) && glm::all(glm::lessThan(entry.position_, position + size)))
+          {
+            result.push_back(entry.object_);
+          }
+        }
+      }
+    }
+
+    // Objects covering more than one cell are found once for each cell, so remove the duplicates.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+  }
+
+  void SpatialGrid::GetOverlappingPairs(const SpatialGridFilter& filter, SpatialGridPairList& pairs) const
+  {
+    std::vector<const SpatialGridEntry*> entries;
+
+    for (const auto& [ key, cell ] : cells_)
+    {
+      entries.clear();
+
+      for (const SpatialGridEntry& entry : cell)
+      {
+        if (filter(entry.object_))
+        {
+          entries.push_back(&entry);
+        }
+      }
+
+      if (entries.size() < 2)
+      {
+        continue;
+      }
+
+      for (size_t first = 0; first < entries.size() - 1; ++first)
+      {
+        for (size_t second = first + 1; second < entries.size(); ++second)
+        {
+          const SpatialGridEntry& lhs = *entries[first];
+          const SpatialGridEntry& rhs = *entries[second];
+
+          if (!glm::all(glm::lessThan(lhs.position_, rhs.position_ + rhs.size_)) || !glm::all(glm::lessThan(rhs.position_, lhs.position_ + lhs.size_)))
+          {
+            continue;
+          }
+
+          // Objects covering more than one cell are compared in each of them, so only keep the pair in the cell where their overlap starts.
+          if (GetCellKey(GetCellPosition(glm::max(lhs.position_, rhs.position_))) == key)
+          {
+            pairs.emplace_back(lhs.object_, rhs.object_);
+          }
+        }
+      }
+    }
+  }
+
+  size_t SpatialGrid::GetCellCount() const
+  {
+    return cells_.size();
+  }
+
+  void SpatialGrid::Clear()
+  {
+    cells_.clear();
+  }
+
+  glm::ivec2 SpatialGrid::GetCellPosition(const glm::ivec2& rowcol)
+  {
+    // Round towards negative infinity, so that cells to the left/above the origin are the same size as the others.
+    const auto floor_divide = [](int value) { return (value < 0 ? value - SPATIAL_GRID_CELL_SIZE + 1 : value) / SPATIAL_GRID_CELL_SIZE; };
+
+    return glm::ivec2(floor_divide(rowcol.x), floor_divide(rowcol.y));
+  }
+
+  uint64_t SpatialGrid::GetCellKey(const glm::ivec2& cell_position)
+  {
+    return ((uint64_t)(uint32_t)cell_position.y << 32) | (uint32_t)cell_position.x;
+  }
+}
@@ -0,0 +1,133 @@
+/// @author James Holtom
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace term_engine::usertypes {
+  class GameObject;
+
+  /// @brief An object stored in a cell of a spatial grid, alongside the area it covers.
+  struct SpatialGridEntry {
+    /// @brief A raw pointer to the object.
+    GameObject* object_;
+    /// @brief The top-left position of the area the object covers, in rows/columns.
+    glm::ivec2 position_;
+    /// @brief The size of the area the object covers, in rows/columns.
+    glm::ivec2 size_;
+  };
+
+  /// @brief Used to store the objects in a cell of a spatial grid.
+  typedef std::vector<SpatialGridEntry> SpatialGridCell;
+  /// @brief Used to store the cells of a spatial grid that contain objects, indexed by their cell position.
+  typedef std::unordered_map<uint64_t, SpatialGridCell> SpatialGridCellList;
+  /// @brief Used to return the objects found by a spatial grid query.
+  typedef std::vector<GameObject*> SpatialGridResult;
+  /// @brief Used to return the pairs of objects whose areas overlap.
+  typedef std::vector<std::pair<GameObject*, GameObject*>> SpatialGridPairList;
+  /// @brief Used to choose which objects are included when finding overlapping pairs.
+  typedef std::function<bool(GameObject*)> SpatialGridFilter;
+
+  /// @brief The size of each cell in a spatial grid, in rows/columns.
+  constexpr int SPATIAL_GRID_CELL_SIZE = 8;
+
+  /**
+   * @brief Indexes the area each object covers in a uniform grid of cells, so that the objects at a position can be found without checking every object.
+   * @details Only cells containing objects are stored, so the grid has no fixed bounds. Objects covering more than one cell are stored in each of them.
+   */
+  class SpatialGrid {
+  public:
+    /// @brief Constructs the spatial grid.
+    SpatialGrid();
+
+    /**
+     * @brief Adds an object to each cell that the given area overlaps.
+     * 
+     * @param[in] object   A raw pointer to the object.
+     * @param[in] position The top-left position of the area the object covers, in rows/columns.
+     * @param[in] size     The size of the area the object covers, in rows/columns.
+     */
+    void Insert(GameObject* object, const glm::ivec2& position, const glm::ivec2& size);
+
+    /**
+     * @brief Removes an object from each cell that the given area overlaps.
+     * @note The area must be the same as the one the object was inserted with.
+     * 
+     * @param[in] object   A raw pointer to the object.
+     * @param[in] position The top-left position of the area the object was inserted with, in rows/columns.
+     * @param[in] size     The size of the area the object was inserted with, in rows/columns.
+     */
+    void Remove(GameObject* object, const glm::ivec2& position, const glm::ivec2& size);
+
+    /**
+     * @brief Returns the objects that cover the given position.
+     * 
+     * @param[in] rowcol The position to check, in rows/columns.
+     * @returns The list of objects, in no particular order.
+     */
+    SpatialGridResult GetObjectsAt(const glm::ivec2& rowcol) const;
+
+    /**
+     * @brief Adds the objects that cover the given position to a list, so that the list can be reused between queries.
+     * 
+     * @param[in]  rowcol The position to check, in rows/columns.
+     * @param[out] result The list to add the objects to, in no particular order.
+     */
+    void GetObjectsAt(const glm::ivec2& rowcol, SpatialGridResult& result) const;
+
+    /**
+     * @brief Returns the objects that overlap the given area.
+     * 
+     * @param[in] position The top-left position of the area, in rows/columns.
+     * @param[in] size     The size of the area, in rows/columns.
+     * @returns The list of objects, in no particular order.
+     */
+    SpatialGridResult GetObjectsInRect(const glm::ivec2& position, const glm::ivec2& size) const;
+
+    /**
+     * @brief Finds each pair of objects whose areas overlap.
+     * @details Only objects in the same cell are compared, and each pair is only found in the cell containing the top-left of the area they overlap, so no pair is found twice.
+     * 
+     * @param[in]  filter The function used to choose which objects are compared.
+     * @param[out] pairs  The list to add the overlapping pairs to.
+     */
+    void GetOverlappingPairs(const SpatialGridFilter& filter, SpatialGridPairList& pairs) const;
+
+    /**
+     * @brief Returns the number of cells that contain objects.
+     * 
+     * @returns The number of cells.
+     */
+    size_t GetCellCount() const;
+
+    /// @brief Removes all objects from the grid.
+    void Clear();
+
+  protected:
+    /// @brief The cells that contain objects.
+    SpatialGridCellList cells_;
+
+    /**
+     * @brief Returns the position of the cell containing the given position.
+     * 
+     * @param[in] rowcol The position, in rows/columns.
+     * @returns The position of the cell, in cells.
+     */
+    static glm::ivec2 GetCellPosition(const glm::ivec2& rowcol);
+
+    /**
+     * @brief Returns the key of the cell at the given position, which is used to index the list of cells.
+     * 
+     * @param[in] cell_position The position of the cell, in cells.
+     * @returns The key for the cell.
+     */
+    static uint64_t GetCellKey(const glm::ivec2& cell_position);
+  };
+}
+
+#endif // ! SPATIAL_GRID_H
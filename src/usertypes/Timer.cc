@@ -1,13 +1,23 @@
 #include "Timer.h"
 
 namespace term_engine::usertypes {
+  void AdvanceFrameClock(uint64_t timestep)
+  {
+    frame_clock_point += std::chrono::nanoseconds(timestep);
+  }
+
   Timer::Timer() :
+    Timer(false)
+  {}
+
+  Timer::Timer(bool follows_frame_clock) :
     start_point_(TimePoint()),
     stop_point_(TimePoint()),
     pause_point_(TimePoint()),
     interval_point_(TimePoint()),
     is_started_(false),
-    is_paused_(false)
+    is_paused_(false),
+    follows_frame_clock_(follows_frame_clock)
   {}
 
   void Timer::Start()
@@ -15,7 +25,7 @@ namespace term_engine::usertypes {
     is_started_ = true;
     is_paused_ = false;
 
-    start_point_ = Clock::now();
+    start_point_ = Now();
     stop_point_ = TimePoint();
     pause_point_ = TimePoint();
     interval_point_ = start_point_;
@@ -26,7 +36,7 @@ namespace term_engine::usertypes {
     is_started_ = false;
     is_paused_ = false;
 
-    stop_point_ = Clock::now();
+    stop_point_ = Now();
     pause_point_ = TimePoint();
     interval_point_ = TimePoint();
   }
@@ -36,7 +46,7 @@ namespace term_engine::usertypes {
     if (is_started_ && !is_paused_) {
       is_paused_ = true;
 
-      pause_point_ = Clock::now();
+      pause_point_ = Now();
     }
   }
 
@@ -45,7 +55,7 @@ namespace term_engine::usertypes {
     if (is_started_ && is_paused_) {
       is_paused_ = false;
 
-      start_point_ += Clock::now() - pause_point_;
+      start_point_ += Now() - pause_point_;
     }
   }
 
@@ -61,29 +71,44 @@ namespace term_engine::usertypes {
 
   uint64_t Timer::GetDuration()
   {
-    uint64_t duration;
+    return GetDurationNs() / NANOSECONDS_PER_MILLISECOND;
+  }
+
+  uint64_t Timer::GetDurationNs()
+  {
+    Clock::duration duration;
 
     if (is_started_) {
       if (is_paused_) {
-        duration = std::chrono::duration_cast<std::chrono::milliseconds>(pause_point_ - start_point_).count();
+        duration = pause_point_ - start_point_;
       }
       else {
-        duration = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_point_).count();
+        duration = Now() - start_point_;
       }
     }
     else {
-      duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop_point_ - start_point_).count();
+      duration = stop_point_ - start_point_;
     }
 
-    return duration;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  }
+
+  double Timer::GetDurationSeconds()
+  {
+    return (double)GetDurationNs() / NANOSECONDS_PER_SECOND;
   }
 
   uint64_t Timer::GetPauseDuration()
+  {
+    return GetPauseDurationNs() / NANOSECONDS_PER_MILLISECOND;
+  }
+
+  uint64_t Timer::GetPauseDurationNs()
   {
     uint64_t duration;
 
     if (is_started_ && is_paused_) {
-      duration = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - pause_point_).count();
+      duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Now() - pause_point_).count();
     }
     else {
       duration = 0;
@@ -93,12 +118,17 @@ namespace term_engine::usertypes {
   }
 
   uint64_t Timer::GetIntervalElapsed()
+  {
+    return GetIntervalElapsedNs() / NANOSECONDS_PER_MILLISECOND;
+  }
+
+  uint64_t Timer::GetIntervalElapsedNs()
   {
     uint64_t elapsed;
-    Clock::time_point now = Clock::now();
+    TimePoint now = Now();
 
     if (is_started_ && !is_paused_) {
-      elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - interval_point_).count();
+      elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - interval_point_).count();
       interval_point_ = now;
     }
     else {
@@ -107,4 +137,14 @@ namespace term_engine::usertypes {
 
     return elapsed;
   }
+
+  double Timer::GetIntervalElapsedSeconds()
+  {
+    return (double)GetIntervalElapsedNs() / NANOSECONDS_PER_SECOND;
+  }
+
+  TimePoint Timer::Now() const
+  {
+    return follows_frame_clock_ && use_frame_clock ? frame_clock_point : Clock::now();
+  }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #define TIMER_H
 
 #include <chrono>
+#include <cstdint>
 
 namespace term_engine::usertypes {
   /// @brief Used to measure time.
@@ -13,12 +14,36 @@ namespace term_engine::usertypes {
   /// @brief Represents a specific point in time.
   using TimePoint = Clock::time_point;
 
+  /// @brief The number of nanoseconds (ns) in a millisecond (ms).
+  constexpr uint64_t NANOSECONDS_PER_MILLISECOND = 1000000;
+  /// @brief The number of nanoseconds (ns) in a second.
+  constexpr double NANOSECONDS_PER_SECOND = 1000000000.0;
+
+  /// @brief Do timers created by Lua measure time with the frame clock? This is only enabled when input is being recorded or replayed, so that the timers read the same durations each time.
+  inline bool use_frame_clock = false;
+  /// @brief The point in time of the current frame, which only moves forward by each frame's timestep.
+  inline TimePoint frame_clock_point = TimePoint();
+
+  /**
+   * @brief Moves the frame clock forward by the given timestep.
+   * 
+   * @param[in] timestep The time since the last frame, in nanoseconds (ns).
+   */
+  void AdvanceFrameClock(uint64_t timestep);
+
   /// @brief Used to measure durations of time.
   class Timer {
   public:
     /// @brief Constructs a _Timer_ object.
     Timer();
 
+    /**
+     * @brief Constructs a _Timer_ object, which can measure time with the frame clock instead.
+     * 
+     * @param[in] follows_frame_clock Should the timer use the frame clock when it is enabled?
+     */
+    explicit Timer(bool follows_frame_clock);
+
     /// @brief Starts the timer.
     void Start();
 
@@ -49,25 +74,65 @@ namespace term_engine::usertypes {
      * @brief Returns the duration of time since the timer was started.
      * @details This excludes any time when the timer is paused.
      * 
-     * @returns The duration of time since the timer was started.
+     * @returns The duration of time since the timer was started, in milliseconds (ms).
      */
     uint64_t GetDuration();
 
+    /**
+     * @brief Returns the duration of time since the timer was started.
+     * @details This excludes any time when the timer is paused.
+     * 
+     * @returns The duration of time since the timer was started, in nanoseconds (ns).
+     */
+    uint64_t GetDurationNs();
+
+    /**
+     * @brief Returns the duration of time since the timer was started.
+     * @details This excludes any time when the timer is paused.
+     * 
+     * @returns The duration of time since the timer was started, in seconds.
+     */
+    double GetDurationSeconds();
+
     /**
      * @brief Returns the duration of time the timer was paused for.
      * 
-     * @returns The duration of time the timer was paused for.
+     * @returns The duration of time the timer was paused for, in milliseconds (ms).
      */
     uint64_t GetPauseDuration();
 
+    /**
+     * @brief Returns the duration of time the timer was paused for.
+     * 
+     * @returns The duration of time the timer was paused for, in nanoseconds (ns).
+     */
+    uint64_t GetPauseDurationNs();
+
     /**
      * @brief Returns the duration of time since the last interval.
      * @details _interval_point_ is also set to now, so the next call to _GetIntervalElapsed_ gets the interval since this call.
+     * @note The interval is truncated to whole milliseconds, so the time lost to rounding isn't counted towards any interval. Use _GetIntervalElapsedNs_ to measure frame times.
      * 
-     * @returns The duration of time since the timer was started, or when _GetIntervalElapsed_ was last called.
+     * @returns The duration of time since the timer was started, or when _GetIntervalElapsed_ was last called, in milliseconds (ms).
      */
     uint64_t GetIntervalElapsed();
 
+    /**
+     * @brief Returns the duration of time since the last interval.
+     * @details _interval_point_ is also set to now, so the next call to _GetIntervalElapsedNs_ gets the interval since this call.
+     * 
+     * @returns The duration of time since the timer was started, or when an interval was last checked, in nanoseconds (ns).
+     */
+    uint64_t GetIntervalElapsedNs();
+
+    /**
+     * @brief Returns the duration of time since the last interval.
+     * @details _interval_point_ is also set to now, so the next call to _GetIntervalElapsedSeconds_ gets the interval since this call.
+     * 
+     * @returns The duration of time since the timer was started, or when an interval was last checked, in seconds.
+     */
+    double GetIntervalElapsedSeconds();
+
   private:
     /// @brief The point in time when the _Timer_ was started.
     Clock::time_point start_point_;
@@ -81,6 +146,15 @@ namespace term_engine::usertypes {
     bool is_started_;
     /// @brief Is the timer paused?
     bool is_paused_;
+    /// @brief Does the timer use the frame clock when it is enabled?
+    bool follows_frame_clock_;
+
+    /**
+     * @brief Returns the current point in time, from either the frame clock or the system clock.
+     * 
+     * @returns The current point in time.
+     */
+    TimePoint Now() const;
   };
 }
 
@@ -1,4 +1,5 @@
 #include "Window.h"
+#include "../events/InputManager.h"
 #include "../utility/GLUtils.h"
 #include "../utility/ImGuiUtils.h"
 #include "../utility/LogUtils.h"
@@ -101,7 +102,8 @@ namespace term_engine::usertypes {
 
   bool Window::IsInFocus() const
   {
-    return window_ == SDL_GetMouseFocus();
+    // The focus is read from the input state, so that it is the same as the recording when input is replayed.
+    return window_ != nullptr && SDL_GetWindowID(window_) == events::mouse_focus_window_id;
   }
 
   bool Window::IsMouseGrabbed() const
@@ -249,6 +251,11 @@ namespace term_engine::usertypes {
     return SDL_GL_GetSwapInterval() != 0;
   }
 
+  int Window::GetVsyncFlag()
+  {
+    return vsync_flag_;
+  }
+
   void Window::SetVsync(int flag)
   {
     if (flag >= -1 && flag <= 1)
@@ -257,6 +264,10 @@ namespace term_engine::usertypes {
       {
         utility::LogError("Failed to set vsync flag: ", SDL_GetError());
       }
+      else
+      {
+        vsync_flag_ = flag;
+      }
     }
     else
     {
@@ -149,6 +149,7 @@ namespace term_engine::usertypes {
 
     /**
      * @brief Returns if the window has mouse focus.
+     * @note This is updated once per frame with the rest of the input state.
      * 
      * @returns If the window has mouse focus.
      */
@@ -277,6 +278,13 @@ namespace term_engine::usertypes {
      */
     static bool IsVsyncEnabled();
 
+    /**
+     * @brief Returns the vsync flag that windows are swapped with.
+     * 
+     * @returns The vsync flag.
+     */
+    static int GetVsyncFlag();
+
     /**
      * @brief Enables/disables vsync.
      * @details If set to `-1`, this function will try to enable adaptive vsync. If this isn't supported, it will fall back to regular vsync.
@@ -0,0 +1,559 @@
+#include <algorithm>
+#include <cstring>
+#include "WorldChunkStore.h"
+#include "../utility/LogUtils.h"
+
+namespace term_engine::usertypes {
+  WorldChunkStore::WorldChunkStore(const std::filesystem::path& filepath, const glm::ivec2& size, const glm::ivec2& chunk_size) :
+    filepath_(filepath),
+    size_(size),
+    chunk_size_(chunk_size),
+    end_offset_(WORLD_FILE_HEADER_SIZE),
+    is_index_dirty_(false),
+    is_busy_(false),
+    is_stopping_(false)
+  {
+    const bool file_exists = std::filesystem::exists(filepath_);
+
+    if (!file_exists)
+    {
+      // Create the file, as fstream will not open a file for reading and writing if it does not exist.
+      std::ofstream create_stream(filepath_, std::ios::binary);
+    }
+
+    file_.open(filepath_, std::ios::in | std::ios::out | std::ios::binary);
+
+    if (!file_.is_open())
+    {
+      utility::LogError("Failed to open world map file {}.", filepath_.string());
+
+      return;
+    }
+
+    if (file_exists)
+    {
+      if (!ReadHeader())
+      {
+        file_.close();
+
+        return;
+      }
+    }
+    else
+    {
+      chunk_count_ = (size_ + chunk_size_ - glm::ivec2(1)) / chunk_size_;
+      index_.resize((size_t)chunk_count_.x * chunk_count_.y);
+
+      WriteHeader(0);
+    }
+
+    io_thread_ = std::thread(&WorldChunkStore::Run, this);
+
+    utility::LogDebug("Opened world map file {} with size {}x{}.", filepath_.string(), size_.x, size_.y);
+  }
+
+  WorldChunkStore::~WorldChunkStore()
+  {
+    if (!file_.is_open())
+    {
+      return;
+    }
+
+    WriteIndex();
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      is_stopping_ = true;
+    }
+
+    request_cv_.notify_all();
+    io_thread_.join();
+
+    // Chunks that are saved again leave their old copy behind, so the file is rewritten once most of it is unused.
+    if (end_offset_ - WORLD_FILE_HEADER_SIZE > GetStoredBytes() * 2)
+    {
+      Compact();
+    }
+
+    file_.close();
+
+    utility::LogDebug("Closed world map file {}.", filepath_.string());
+  }
+
+  bool WorldChunkStore::IsOpen() const
+  {
+    return file_.is_open();
+  }
+
+  glm::ivec2 WorldChunkStore::GetSize() const
+  {
+    return size_;
+  }
+
+  bool WorldChunkStore::HasChunk(const glm::ivec2& chunk_position) const
+  {
+    if (glm::any(glm::lessThan(chunk_position, glm::ivec2(0))) || glm::any(glm::greaterThanEqual(chunk_position, chunk_count_)))
+    {
+      return false;
+    }
+
+    return index_[GetChunkIndex(chunk_position)].length_ > 0;
+  }
+
+  size_t WorldChunkStore::GetStoredChunkCount() const
+  {
+    return std::count_if(index_.begin(), index_.end(), [](const ChunkLocation& location) { return location.length_ > 0; });
+  }
+
+  void WorldChunkStore::RequestLoad(const glm::ivec2& chunk_position)
+  {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      requests_.push_back({ false, chunk_position, index_.at(GetChunkIndex(chunk_position)), ChunkPayload() });
+    }
+
+    request_cv_.notify_one();
+  }
+
+  CharacterData WorldChunkStore::Load(const glm::ivec2& chunk_position)
+  {
+    // Queued writes must land before reading, otherwise an older copy of the chunk could be read.
+    Flush();
+
+    return ReadChunk(index_.at(GetChunkIndex(chunk_position)));
+  }
+
+  void WorldChunkStore::Save(const glm::ivec2& chunk_position, const CharacterData& data)
+  {
+    ChunkPayload payload = Encode(data);
+    ChunkLocation& location = index_.at(GetChunkIndex(chunk_position));
+
+    // Chunks are always appended, so that a queued read of the chunk's previous location is not overwritten.
+    location.offset_ = end_offset_;
+    location.length_ = (uint32_t)payload.size();
+    end_offset_ += payload.size();
+    is_index_dirty_ = true;
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      requests_.push_back({ true, chunk_position, location, std::move(payload) });
+    }
+
+    request_cv_.notify_one();
+  }
+
+  LoadedChunkList WorldChunkStore::TakeLoadedChunks()
+  {
+    LoadedChunkList result;
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      result.swap(loaded_);
+    }
+
+    return result;
+  }
+
+  void WorldChunkStore::WriteIndex()
+  {
+    Flush();
+
+    // The world map saves before the store is destroyed, so the index is only appended again if a chunk was saved since.
+    if (!is_index_dirty_)
+    {
+      return;
+    }
+
+    const ChunkPayload payload = EncodeIndex(index_);
+    const uint64_t index_offset = end_offset_;
+
+    // The index is appended after the last chunk, so that chunks saved afterwards don't overwrite it.
+    WriteChunk({ index_offset, (uint32_t)payload.size() }, payload);
+    end_offset_ += payload.size();
+
+    {
+      std::lock_guard<std::mutex> lock(file_mutex_);
+      file_.flush();
+    }
+
+    // The header is only pointed at the new index once the index is in the file, so that it never points at a partly written index.
+    WriteHeader(index_offset);
+    is_index_dirty_ = false;
+
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    file_.flush();
+  }
+
+  void WorldChunkStore::Clear()
+  {
+    Flush();
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      loaded_.clear();
+    }
+
+    std::fill(index_.begin(), index_.end(), ChunkLocation());
+    end_offset_ = WORLD_FILE_HEADER_SIZE;
+    is_index_dirty_ = false;
+
+    WriteHeader(0);
+  }
+
+  uint64_t WorldChunkStore::GetStoredBytes() const
+  {
+    uint64_t stored_bytes = index_.size() * WORLD_FILE_INDEX_ENTRY_SIZE;
+
+    for (const ChunkLocation& location : index_)
+    {
+      stored_bytes += location.length_;
+    }
+
+    return stored_bytes;
+  }
+
+  size_t WorldChunkStore::GetChunkIndex(const glm::ivec2& chunk_position) const
+  {
+    return ((size_t)chunk_position.y * chunk_count_.x) + chunk_position.x;
+  }
+
+  bool WorldChunkStore::ReadHeader()
+  {
+    char magic[4];
+    uint32_t version;
+    glm::ivec2 size;
+    glm::ivec2 chunk_size;
+    uint64_t index_offset;
+
+    file_.seekg(0);
+    file_.read(magic, sizeof(magic));
+    file_.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+    file_.read(reinterpret_cast<char*>(&size.x), sizeof(int32_t));
+    file_.read(reinterpret_cast<char*>(&size.y), sizeof(int32_t));
+    file_.read(reinterpret_cast<char*>(&chunk_size.x), sizeof(int32_t));
+    file_.read(reinterpret_cast<char*>(&chunk_size.y), sizeof(int32_t));
+    file_.read(reinterpret_cast<char*>(&index_offset), sizeof(uint64_t));
+
+    if (!file_ || std::memcmp(magic, WORLD_FILE_MAGIC, sizeof(magic)) != 0)
+    {
+      utility::LogError("{} is not a world map file!", filepath_.string());
+
+      return false;
+    }
+    else if (version != WORLD_FILE_VERSION)
+    {
+      utility::LogError("World map file {} has unsupported version {}!", filepath_.string(), version);
+
+      return false;
+    }
+    else if (size.x <= 0 || size.y <= 0)
+    {
+      utility::LogError("World map file {} has an invalid size of {}x{}!", filepath_.string(), size.x, size.y);
+
+      return false;
+    }
+    else if (chunk_size != chunk_size_)
+    {
+      utility::LogError("World map file {} has a chunk size of {}x{}, expected {}x{}!", filepath_.string(), chunk_size.x, chunk_size.y, chunk_size_.x, chunk_size_.y);
+
+      return false;
+    }
+
+    if (size != size_)
+    {
+      utility::LogWarn("World map file {} has a size of {}x{}, using that instead of {}x{}.", filepath_.string(), size.x, size.y, size_.x, size_.y);
+
+      size_ = size;
+    }
+
+    chunk_count_ = (size_ + chunk_size_ - glm::ivec2(1)) / chunk_size_;
+    index_.resize((size_t)chunk_count_.x * chunk_count_.y);
+
+    // A file without an index has not been saved yet, so has no chunks.
+    if (index_offset == 0)
+    {
+      return true;
+    }
+
+    ChunkPayload payload;
+    payload.resize(index_.size() * WORLD_FILE_INDEX_ENTRY_SIZE);
+
+    file_.seekg(index_offset);
+    file_.read(payload.data(), payload.size());
+
+    if (!file_)
+    {
+      utility::LogError("Failed to read the index of world map file {}!", filepath_.string());
+
+      return false;
+    }
+
+    const char* cursor = payload.data();
+
+    for (ChunkLocation& location : index_)
+    {
+      std::memcpy(&location.offset_, cursor, sizeof(uint64_t));
+      std::memcpy(&location.length_, cursor + sizeof(uint64_t), sizeof(uint32_t));
+      cursor += WORLD_FILE_INDEX_ENTRY_SIZE;
+    }
+
+    // New chunks are written after the index, so that the header still points at a complete index if the file isn't closed properly.
+    end_offset_ = index_offset + payload.size();
+
+    return true;
+  }
+
+  void WorldChunkStore::WriteHeader(uint64_t index_offset)
+  {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+
+    file_.seekp(0);
+    WriteHeader(file_, index_offset);
+  }
+
+  void WorldChunkStore::WriteHeader(std::ostream& stream, uint64_t index_offset) const
+  {
+    stream.write(WORLD_FILE_MAGIC, sizeof(WORLD_FILE_MAGIC));
+    stream.write(reinterpret_cast<const char*>(&WORLD_FILE_VERSION), sizeof(uint32_t));
+    stream.write(reinterpret_cast<const char*>(&size_.x), sizeof(int32_t));
+    stream.write(reinterpret_cast<const char*>(&size_.y), sizeof(int32_t));
+    stream.write(reinterpret_cast<const char*>(&chunk_size_.x), sizeof(int32_t));
+    stream.write(reinterpret_cast<const char*>(&chunk_size_.y), sizeof(int32_t));
+    stream.write(reinterpret_cast<const char*>(&index_offset), sizeof(uint64_t));
+  }
+
+  CharacterData WorldChunkStore::ReadChunk(const ChunkLocation& location)
+  {
+    ChunkPayload payload;
+    payload.resize(location.length_);
+
+    {
+      std::lock_guard<std::mutex> lock(file_mutex_);
+
+      file_.clear();
+      file_.seekg(location.offset_);
+      file_.read(payload.data(), payload.size());
+
+      if (!file_)
+      {
+        file_.clear();
+
+        return CharacterData();
+      }
+    }
+
+    return Decode(payload, (size_t)chunk_size_.x * chunk_size_.y);
+  }
+
+  void WorldChunkStore::WriteChunk(const ChunkLocation& location, const ChunkPayload& payload)
+  {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+
+    file_.clear();
+    file_.seekp(location.offset_);
+    file_.write(payload.data(), payload.size());
+  }
+
+  void WorldChunkStore::Compact()
+  {
+    const std::filesystem::path temp_path = filepath_.string() + ".tmp";
+    std::ofstream temp_file(temp_path, std::ios::binary | std::ios::trunc);
+
+    if (!temp_file.is_open())
+    {
+      utility::LogWarn("Failed to create {} to compact world map file {}.", temp_path.string(), filepath_.string());
+
+      return;
+    }
+
+    std::vector<ChunkLocation> compacted_index(index_.size());
+    uint64_t offset = WORLD_FILE_HEADER_SIZE;
+    ChunkPayload payload;
+
+    // The chunks are written in order straight after the header, so the index follows the last of them.
+    for (const ChunkLocation& location : index_)
+    {
+      offset += location.length_;
+    }
+
+    WriteHeader(temp_file, offset);
+    offset = WORLD_FILE_HEADER_SIZE;
+
+    for (size_t i = 0; i < index_.size(); ++i)
+    {
+      const ChunkLocation& location = index_[i];
+
+      if (location.length_ == 0)
+      {
+        continue;
+      }
+
+      payload.resize(location.length_);
+      file_.clear();
+      file_.seekg(location.offset_);
+      file_.read(payload.data(), payload.size());
+
+      if (!file_)
+      {
+        utility::LogWarn("Failed to read a chunk while compacting world map file {}, leaving it as it is.", filepath_.string());
+        file_.clear();
+        temp_file.close();
+        std::filesystem::remove(temp_path);
+
+        return;
+      }
+
+      temp_file.write(payload.data(), payload.size());
+      compacted_index[i] = { offset, location.length_ };
+      offset += location.length_;
+    }
+
+    payload = EncodeIndex(compacted_index);
+    temp_file.write(payload.data(), payload.size());
+    temp_file.close();
+
+    if (!temp_file)
+    {
+      utility::LogWarn("Failed to write {} while compacting world map file {}, leaving it as it is.", temp_path.string(), filepath_.string());
+      std::filesystem::remove(temp_path);
+
+      return;
+    }
+
+    const uint64_t previous_size = end_offset_;
+    std::error_code error;
+
+    file_.close();
+    std::filesystem::rename(temp_path, filepath_, error);
+
+    if (error)
+    {
+      utility::LogWarn("Failed to replace world map file {} with its compacted copy. Error: {}", filepath_.string(), error.message());
+      std::filesystem::remove(temp_path, error);
+
+      return;
+    }
+
+    index_ = std::move(compacted_index);
+    end_offset_ = offset + payload.size();
+
+    utility::LogDebug("Compacted world map file {} from {} to {} bytes.", filepath_.string(), previous_size, end_offset_);
+  }
+
+  void WorldChunkStore::Flush()
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    idle_cv_.wait(lock, [this] { return requests_.empty() && !is_busy_; });
+  }
+
+  void WorldChunkStore::Run()
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+
+    while (true)
+    {
+      request_cv_.wait(lock, [this] { return is_stopping_ || !requests_.empty(); });
+
+      if (requests_.empty())
+      {
+        break;
+      }
+
+      ChunkRequest request = std::move(requests_.front());
+      requests_.pop_front();
+      is_busy_ = true;
+
+      lock.unlock();
+
+      if (request.is_save_)
+      {
+        WriteChunk(request.location_, request.payload_);
+        lock.lock();
+      }
+      else
+      {
+        CharacterData data = ReadChunk(request.location_);
+        lock.lock();
+        loaded_.emplace_back(request.position_, std::move(data));
+      }
+
+      is_busy_ = false;
+      idle_cv_.notify_all();
+    }
+  }
+
+  ChunkPayload WorldChunkStore::EncodeIndex(const std::vector<ChunkLocation>& index)
+  {
+    ChunkPayload payload;
+    payload.resize(index.size() * WORLD_FILE_INDEX_ENTRY_SIZE);
+
+    char* cursor = payload.data();
+
+    for (const ChunkLocation& location : index)
+    {
+      std::memcpy(cursor, &location.offset_, sizeof(uint64_t));
+      std::memcpy(cursor + sizeof(uint64_t), &location.length_, sizeof(uint32_t));
+      cursor += WORLD_FILE_INDEX_ENTRY_SIZE;
+    }
+
+    return payload;
+  }
+
+  ChunkPayload WorldChunkStore::Encode(const CharacterData& data)
+  {
+    ChunkPayload payload;
+    auto it = data.begin();
+
+    while (it != data.end())
+    {
+      auto run_end = std::find_if(it, data.end(), [&it](const Character& character) { return !(character == *it); });
+      const uint16_t run_length = (uint16_t)std::min<ptrdiff_t>(run_end - it, UINT16_MAX);
+      const uint16_t character = (uint16_t)it->character_;
+      uint8_t colours[8];
+
+      for (int i = 0; i < 4; ++i)
+      {
+        colours[i] = (uint8_t)glm::clamp(it->foreground_colour_[i], 0.0f, 255.0f);
+        colours[i + 4] = (uint8_t)glm::clamp(it->background_colour_[i], 0.0f, 255.0f);
+      }
+
+      const size_t offset = payload.size();
+      payload.resize(offset + WORLD_FILE_RUN_SIZE);
+      std::memcpy(payload.data() + offset, &run_length, sizeof(uint16_t));
+      std::memcpy(payload.data() + offset + 2, &character, sizeof(uint16_t));
+      std::memcpy(payload.data() + offset + 4, colours, sizeof(colours));
+
+      it += run_length;
+    }
+
+    return payload;
+  }
+
+  CharacterData WorldChunkStore::Decode(const ChunkPayload& payload, size_t count)
+  {
+    CharacterData data;
+    data.reserve(count);
+
+    for (size_t offset = 0; offset + WORLD_FILE_RUN_SIZE <= payload.size(); offset += WORLD_FILE_RUN_SIZE)
+    {
+      uint16_t run_length;
+      uint16_t character;
+      uint8_t colours[8];
+
+      std::memcpy(&run_length, payload.data() + offset, sizeof(uint16_t));
+      std::memcpy(&character, payload.data() + offset + 2, sizeof(uint16_t));
+      std::memcpy(colours, payload.data() + offset + 4, sizeof(colours));
+
+      if (data.size() + run_length > count)
+      {
+        return CharacterData();
+      }
+
+      data.insert(data.end(), run_length, Character((char16_t)character,
+        glm::vec4(colours[0], colours[1], colours[2], colours[3]),
+        glm::vec4(colours[4], colours[5], colours[6], colours[7])));
+    }
+
+    return data.size() == count ? data : CharacterData();
+  }
+}
@@ -0,0 +1,274 @@
+/// @author James Holtom
+
+#ifndef WORLD_CHUNK_STORE_H
+#define WORLD_CHUNK_STORE_H
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Character.h"
+
+namespace term_engine::usertypes {
+  /// @brief Used to store the chunks that have finished loading, alongside their chunk position.
+  typedef std::vector<std::pair<glm::ivec2, CharacterData>> LoadedChunkList;
+  /// @brief Used to store the encoded contents of a chunk.
+  typedef std::vector<char> ChunkPayload;
+
+  /// @brief The identifier at the start of every world map file.
+  constexpr char WORLD_FILE_MAGIC[4] = { 'T', 'E', 'W', 'M' };
+  /// @brief The version of the world map file format.
+  constexpr uint32_t WORLD_FILE_VERSION = 1;
+  /// @brief The size of the header at the start of every world map file, in bytes.
+  constexpr uint64_t WORLD_FILE_HEADER_SIZE = 32;
+  /// @brief The size of each entry in a world map file's chunk index, in bytes.
+  constexpr uint64_t WORLD_FILE_INDEX_ENTRY_SIZE = 12;
+  /// @brief The size of each run of identical characters in an encoded chunk, in bytes.
+  constexpr uint64_t WORLD_FILE_RUN_SIZE = 12;
+
+  /// @brief Describes where a chunk is stored in a world map file.
+  struct ChunkLocation {
+    /// @brief The offset of the chunk from the start of the file, in bytes.
+    uint64_t offset_ = 0;
+    /// @brief The size of the encoded chunk, in bytes. If 0, the chunk is not stored in the file.
+    uint32_t length_ = 0;
+  };
+
+  /// @brief Describes a chunk to be read from, or written to a world map file by the I/O thread.
+  struct ChunkRequest {
+    /// @brief Is the chunk being written to the file?
+    bool is_save_;
+    /// @brief The position of the chunk, in chunks.
+    glm::ivec2 position_;
+    /// @brief Where the chunk is stored in the file.
+    ChunkLocation location_;
+    /// @brief The encoded chunk to write, if saving.
+    ChunkPayload payload_;
+  };
+
+  /**
+   * @brief Stores the chunks of a world map in a binary file, which are read and written on a background I/O thread.
+   * @details The file starts with a header, followed by the encoded chunks, and then an index of where each chunk is in the file.
+   *          Each chunk is stored as runs of identical characters, so empty and repetitive chunks take up little space.
+   *          Chunks that are saved again are appended to the file, and a new index is appended after them when the store is saved.
+   *          This leaves the old copies of those chunks in the file, so the file is compacted when the store is closed if most of it is unused.
+   */
+  class WorldChunkStore {
+  public:
+    /**
+     * @brief Opens the world map file at the given path, creating it if it does not exist.
+     * 
+     * @param[in] filepath   The path to the world map file.
+     * @param[in] size       The size of the world map, in rows/columns. If the file already exists, the size stored in the file is used instead.
+     * @param[in] chunk_size The size of each chunk, in rows/columns.
+     */
+    WorldChunkStore(const std::filesystem::path& filepath, const glm::ivec2& size, const glm::ivec2& chunk_size);
+
+    /// @brief Finishes any queued reads/writes, saves the index if it has changed and closes the world map file.
+    ~WorldChunkStore();
+
+    /**
+     * @brief Returns if the world map file was opened successfully.
+     * 
+     * @returns If the file is open.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Returns the size of the world map stored in the file.
+     * 
+     * @returns The size of the world map, in rows/columns.
+     */
+    glm::ivec2 GetSize() const;
+
+    /**
+     * @brief Returns if the chunk at the given position is stored in the file.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns If the chunk is stored in the file, or false if the position is outside of the world map.
+     */
+    bool HasChunk(const glm::ivec2& chunk_position) const;
+
+    /**
+     * @brief Returns the number of chunks stored in the file.
+     * 
+     * @returns The number of stored chunks.
+     */
+    size_t GetStoredChunkCount() const;
+
+    /**
+     * @brief Queues the chunk at the given position to be read by the I/O thread.
+     * @note Once read, the chunk is returned by the next call to _TakeLoadedChunks_.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     */
+    void RequestLoad(const glm::ivec2& chunk_position);
+
+    /**
+     * @brief Reads the chunk at the given position, waiting for any queued reads/writes to finish first.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns The character data of the chunk, or an empty list if it could not be read.
+     */
+    CharacterData Load(const glm::ivec2& chunk_position);
+
+    /**
+     * @brief Queues the given chunk to be written to the file by the I/O thread.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @param[in] data           The character data of the chunk.
+     */
+    void Save(const glm::ivec2& chunk_position, const CharacterData& data);
+
+    /**
+     * @brief Returns the chunks that the I/O thread has finished reading since the last call.
+     * @note Chunks that could not be read are returned with an empty list of character data.
+     * 
+     * @returns The list of loaded chunks.
+     */
+    LoadedChunkList TakeLoadedChunks();
+
+    /**
+     * @brief Waits for all queued reads/writes to finish, and appends the index to the file if any chunks were saved since it was last written.
+     * @details The header is updated to point at the new index once the index has been written.
+     */
+    void WriteIndex();
+
+    /// @brief Removes all chunks from the file.
+    void Clear();
+
+  protected:
+    /// @brief The path to the world map file.
+    std::filesystem::path filepath_;
+    /// @brief The world map file.
+    std::fstream file_;
+    /// @brief The size of the world map, in rows/columns.
+    glm::ivec2 size_;
+    /// @brief The size of each chunk, in rows/columns.
+    glm::ivec2 chunk_size_;
+    /// @brief The number of chunks along each axis of the world map.
+    glm::ivec2 chunk_count_;
+    /// @brief Where each chunk is stored in the file.
+    std::vector<ChunkLocation> index_;
+    /// @brief The offset of the end of the last chunk in the file, where new chunks are written to.
+    uint64_t end_offset_;
+    /// @brief Have any chunks been saved since the index was last written to the file?
+    bool is_index_dirty_;
+    /// @brief The thread that reads/writes chunks to the file in the background.
+    std::thread io_thread_;
+    /// @brief Guards the request queue, loaded chunks and thread state.
+    std::mutex queue_mutex_;
+    /// @brief Guards access to the file.
+    std::mutex file_mutex_;
+    /// @brief Signals the I/O thread that a request has been queued, or that it should stop.
+    std::condition_variable request_cv_;
+    /// @brief Signals that the I/O thread has finished all queued requests.
+    std::condition_variable idle_cv_;
+    /// @brief The queue of reads/writes for the I/O thread, in the order they were requested.
+    std::deque<ChunkRequest> requests_;
+    /// @brief The chunks that have been read by the I/O thread, but not taken by the world map.
+    LoadedChunkList loaded_;
+    /// @brief Is the I/O thread processing a request?
+    bool is_busy_;
+    /// @brief Should the I/O thread stop once the queue is empty?
+    bool is_stopping_;
+
+    /**
+     * @brief Returns the number of bytes in the file that are used by the stored chunks and the index.
+     * 
+     * @returns The number of bytes in use.
+     */
+    uint64_t GetStoredBytes() const;
+
+    /**
+     * @brief Returns the index of the chunk at the given position.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns The index of the chunk.
+     */
+    size_t GetChunkIndex(const glm::ivec2& chunk_position) const;
+
+    /**
+     * @brief Reads the header and index from the file.
+     * 
+     * @returns If the file was read successfully.
+     */
+    bool ReadHeader();
+
+    /**
+     * @brief Writes the header to the file.
+     * 
+     * @param[in] index_offset The offset of the index from the start of the file, in bytes. If 0, the file has no index.
+     */
+    void WriteHeader(uint64_t index_offset);
+
+    /**
+     * @brief Writes the header to the given stream, at its current position.
+     * 
+     * @param[in,out] stream       The stream to write to.
+     * @param[in]     index_offset The offset of the index from the start of the file, in bytes. If 0, the file has no index.
+     */
+    void WriteHeader(std::ostream& stream, uint64_t index_offset) const;
+
+    /**
+     * @brief Reads and decodes the chunk at the given location in the file.
+     * 
+     * @param[in] location Where the chunk is stored in the file.
+     * @returns The character data of the chunk, or an empty list if it could not be read.
+     */
+    CharacterData ReadChunk(const ChunkLocation& location);
+
+    /**
+     * @brief Writes an encoded chunk to the given location in the file.
+     * 
+     * @param[in] location Where to write the chunk in the file.
+     * @param[in] payload  The encoded chunk.
+     */
+    void WriteChunk(const ChunkLocation& location, const ChunkPayload& payload);
+
+    /**
+     * @brief Rewrites the file with only the current copy of each chunk, removing the copies left behind by chunks that were saved again.
+     * @details The compacted file is written alongside the original, and only replaces it once it has been written completely.
+     * @warning This closes the file, so must only be called when the store is being destroyed and the I/O thread has stopped.
+     */
+    void Compact();
+
+    /// @brief Waits for the I/O thread to finish all queued requests.
+    void Flush();
+
+    /// @brief Processes queued requests on the I/O thread until the store is destroyed.
+    void Run();
+
+    /**
+     * @brief Encodes the index of where each chunk is stored in the file.
+     * 
+     * @param[in] index The location of each chunk.
+     * @returns The encoded index.
+     */
+    static ChunkPayload EncodeIndex(const std::vector<ChunkLocation>& index);
+
+    /**
+     * @brief Encodes the character data of a chunk as runs of identical characters.
+     * 
+     * @param[in] data The character data to encode.
+     * @returns The encoded chunk.
+     */
+    static ChunkPayload Encode(const CharacterData& data);
+
+    /**
+     * @brief Decodes a chunk into character data.
+     * 
+     * @param[in] payload The encoded chunk.
+     * @param[in] count   The number of characters in the chunk.
+     * @returns The character data of the chunk, or an empty list if the chunk is malformed.
+     */
+    static CharacterData Decode(const ChunkPayload& payload, size_t count);
+  };
+}
+
+#endif // ! WORLD_CHUNK_STORE_H
@@ -0,0 +1,388 @@
+#include <cinttypes>
+#include <vector>
+#include "WorldMap.h"
+#include "../system/FileFunctions.h"
+#include "../utility/ConversionUtils.h"
+#include "../utility/ImGuiUtils.h"
+#include "../utility/LogUtils.h"
+
+namespace term_engine::usertypes {
+  WorldMap::WorldMap(const glm::ivec2& size) :
+    size_(glm::max(size, glm::ivec2(0))),
+    camera_position_(glm::ivec2(0)),
+    camera_size_(glm::ivec2(0)),
+    store_(nullptr),
+    memory_budget_(DEFAULT_WORLD_MAP_MEMORY_BUDGET),
+    chunks_drawn_(0)
+  {
+    utility::LogDebug("Created world map with size {}x{}.", size_.x, size_.y);
+  }
+
+  WorldMap::WorldMap(const std::string& filename, const glm::ivec2& size) :
+    size_(glm::max(size, glm::ivec2(0))),
+    camera_position_(glm::ivec2(0)),
+    camera_size_(glm::ivec2(0)),
+    store_(std::make_unique<WorldChunkStore>(system::GetProjectFilePath(filename), size_, WORLD_CHUNK_SIZE)),
+    memory_budget_(DEFAULT_WORLD_MAP_MEMORY_BUDGET),
+    chunks_drawn_(0)
+  {
+    if (store_->IsOpen())
+    {
+      size_ = store_->GetSize();
+
+      utility::LogDebug("Created streamed world map from \"{}\" with size {}x{}.", filename, size_.x, size_.y);
+    }
+    else
+    {
+      store_.reset();
+
+      utility::LogWarn("Could not stream world map from \"{}\", keeping it in memory instead.", filename);
+    }
+  }
+
+  WorldMap::~WorldMap()
+  {
+    Save();
+  }
+
+  glm::ivec2 WorldMap::GetSize() const
+  {
+    return size_;
+  }
+
+  glm::ivec2& WorldMap::GetCameraPosition()
+  {
+    return camera_position_;
+  }
+
+  glm::ivec2 WorldMap::GetCameraSize() const
+  {
+    return camera_size_;
+  }
+
+  size_t WorldMap::GetChunkCount() const
+  {
+    return chunks_.size();
+  }
+
+  bool WorldMap::IsStreamed() const
+  {
+    return store_ != nullptr;
+  }
+
+  uint64_t WorldMap::GetMemoryBudget() const
+  {
+    return memory_budget_;
+  }
+
+  Character WorldMap::GetCharacter(const glm::ivec2& rowcol)
+  {
+    const glm::ivec2 chunk_position = rowcol / WORLD_CHUNK_SIZE;
+
+    if (!IsInside(rowcol) || !HasChunk(chunk_position))
+    {
+      return Character();
+    }
+
+    return LoadChunk(chunk_position).data_.GetCharacter(rowcol % WORLD_CHUNK_SIZE);
+  }
+
+  void WorldMap::SetMemoryBudget(uint64_t budget)
+  {
+    memory_budget_ = budget;
+  }
+
+  void WorldMap::SetCameraPosition(const glm::ivec2& position)
+  {
+    camera_position_ = position;
+  }
+
+  void WorldMap::CenterCamera(const glm::ivec2& rowcol)
+  {
+    camera_position_ = glm::clamp(rowcol - (camera_size_ / 2), glm::ivec2(0), glm::max(size_ - camera_size_, glm::ivec2(0)));
+  }
+
+  void WorldMap::SetCharacter(const glm::ivec2& rowcol, const Character& character)
+  {
+    if (!IsInside(rowcol))
+    {
+      return;
+    }
+
+    const glm::ivec2 chunk_position = rowcol / WORLD_CHUNK_SIZE;
+
+    // Empty characters do not need a chunk allocating for them.
+    if (character.character_ != NO_CHARACTER || HasChunk(chunk_position))
+    {
+      GetOrAddChunk(chunk_position)->GetData().at(utility::GetIndexFromRowCol(WORLD_CHUNK_SIZE, rowcol % WORLD_CHUNK_SIZE)) = character;
+    }
+  }
+
+  void WorldMap::Fill(const glm::ivec2& position, const glm::ivec2& size, const Character& character)
+  {
+    const glm::ivec2 start = glm::max(position, glm::ivec2(0));
+    const glm::ivec2 end = glm::min(position + size, size_);
+
+    for (int y = start.y; y < end.y; ++y)
+    {
+      for (int x = start.x; x < end.x; ++x)
+      {
+        SetCharacter(glm::ivec2(x, y), character);
+      }
+    }
+  }
+
+  void WorldMap::PushCharacters(const glm::ivec2& position, CharacterMap& data)
+  {
+    const glm::ivec2 size = data.GetSize();
+
+    for (int y = 0; y < size.y; ++y)
+    {
+      for (int x = 0; x < size.x; ++x)
+      {
+        SetCharacter(position + glm::ivec2(x, y), data.GetCharacter(glm::ivec2(x, y)));
+      }
+    }
+  }
+
+  void WorldMap::Clear()
+  {
+    chunks_.clear();
+    lru_list_.clear();
+    pending_loads_.clear();
+
+    if (store_ != nullptr)
+    {
+      store_->Clear();
+    }
+
+    utility::LogDebug("Cleared all chunks from world map.");
+  }
+
+  void WorldMap::Save()
+  {
+    if (store_ == nullptr)
+    {
+      return;
+    }
+
+    for (auto& [ key, chunk ] : chunks_)
+    {
+      if (chunk.is_dirty_)
+      {
+        store_->Save(GetChunkPosition(key), chunk.data_.GetData());
+        chunk.is_dirty_ = false;
+      }
+    }
+
+    store_->WriteIndex();
+  }
+
+  void WorldMap::Draw(CharacterMap* character_map)
+  {
+    camera_size_ = character_map->GetSize();
+    chunks_drawn_ = 0;
+
+    // Only the chunks that overlap the camera are visited, so the cost of drawing does not depend on the size of the world.
+    const glm::ivec2 first_chunk = glm::max(camera_position_, glm::ivec2(0)) / WORLD_CHUNK_SIZE;
+    const glm::ivec2 last_chunk = (glm::min(camera_position_ + camera_size_, size_) - glm::ivec2(1)) / WORLD_CHUNK_SIZE;
+
+    if (store_ != nullptr)
+    {
+      const glm::ivec2 max_chunk = (size_ - glm::ivec2(1)) / WORLD_CHUNK_SIZE;
+      const glm::ivec2 first_stream_chunk = glm::max(first_chunk - glm::ivec2(WORLD_MAP_STREAM_DISTANCE), glm::ivec2(0));
+      const glm::ivec2 last_stream_chunk = glm::min(last_chunk + glm::ivec2(WORLD_MAP_STREAM_DISTANCE), max_chunk);
+
+      StreamChunks(first_stream_chunk, last_stream_chunk);
+      EvictChunks(first_stream_chunk, last_stream_chunk);
+    }
+
+    for (int y = first_chunk.y; y <= last_chunk.y; ++y)
+    {
+      for (int x = first_chunk.x; x <= last_chunk.x; ++x)
+      {
+        const glm::ivec2 chunk_position = glm::ivec2(x, y);
+        CharacterMap* chunk = GetChunk(chunk_position);
+
+        if (chunk != nullptr)
+        {
+          character_map->PushCharacters((chunk_position * WORLD_CHUNK_SIZE) - camera_position_, *chunk, WORLD_MAP_DEPTH);
+          ++chunks_drawn_;
+        }
+      }
+    }
+  }
+
+  void WorldMap::UpdateDebugInfo() const
+  {
+    if (ImGui::TreeNode("World Map"))
+    {
+      ImGui::Text("Size: %i, %i", size_.x, size_.y);
+      ImGui::Text("Camera Position: %i, %i", camera_position_.x, camera_position_.y);
+      ImGui::Text("Camera Size: %i, %i", camera_size_.x, camera_size_.y);
+      ImGui::Text("Chunks Loaded: %zu", chunks_.size());
+      ImGui::Text("Chunks Drawn: %zu", chunks_drawn_);
+
+      if (store_ != nullptr)
+      {
+        ImGui::Text("Chunks Stored: %zu", store_->GetStoredChunkCount());
+        ImGui::Text("Chunks Loading: %zu", pending_loads_.size());
+        ImGui::Text("Memory Used: %" PRIu64 " / %" PRIu64 " bytes", (uint64_t)(chunks_.size() * WORLD_CHUNK_BYTES), memory_budget_);
+      }
+
+      ImGui::TreePop();
+    }
+  }
+
+  bool WorldMap::IsInside(const glm::ivec2& rowcol) const
+  {
+    return glm::all(glm::greaterThanEqual(rowcol, glm::ivec2(0))) && glm::all(glm::lessThan(rowcol, size_));
+  }
+
+  uint64_t WorldMap::GetChunkKey(const glm::ivec2& chunk_position)
+  {
+    return ((uint64_t)(uint32_t)chunk_position.y << 32) | (uint32_t)chunk_position.x;
+  }
+
+  glm::ivec2 WorldMap::GetChunkPosition(uint64_t key)
+  {
+    return glm::ivec2((int32_t)(uint32_t)key, (int32_t)(uint32_t)(key >> 32));
+  }
+
+  bool WorldMap::HasChunk(const glm::ivec2& chunk_position) const
+  {
+    return chunks_.contains(GetChunkKey(chunk_position)) || (store_ != nullptr && store_->HasChunk(chunk_position));
+  }
+
+  CharacterMap* WorldMap::GetChunk(const glm::ivec2& chunk_position)
+  {
+    WorldChunkList::iterator it = chunks_.find(GetChunkKey(chunk_position));
+
+    if (it == chunks_.end())
+    {
+      return nullptr;
+    }
+
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_position_);
+
+    return &it->second.data_;
+  }
+
+  CharacterMap* WorldMap::GetOrAddChunk(const glm::ivec2& chunk_position)
+  {
+    WorldChunk& chunk = LoadChunk(chunk_position);
+    chunk.is_dirty_ = true;
+
+    return &chunk.data_;
+  }
+
+  WorldChunk& WorldMap::LoadChunk(const glm::ivec2& chunk_position)
+  {
+    const uint64_t key = GetChunkKey(chunk_position);
+    WorldChunkList::iterator it = chunks_.find(key);
+    WorldChunk* chunk = nullptr;
+
+    if (it != chunks_.end())
+    {
+      chunk = &it->second;
+      lru_list_.splice(lru_list_.begin(), lru_list_, chunk->lru_position_);
+    }
+    else if (store_ != nullptr && store_->HasChunk(chunk_position))
+    {
+      // The chunk is needed now, so it is loaded immediately rather than waiting for the I/O thread.
+      chunk = &AddChunk(key, store_->Load(chunk_position));
+    }
+    else
+    {
+      chunk = &AddChunk(key, CharacterData());
+    }
+
+    return *chunk;
+  }
+
+  WorldChunk& WorldMap::AddChunk(uint64_t key, CharacterData&& data)
+  {
+    WorldChunk& chunk = chunks_.emplace(key, WorldChunk()).first->second;
+    chunk.data_.SetSize(WORLD_CHUNK_SIZE);
+    chunk.is_dirty_ = false;
+
+    if (data.size() == chunk.data_.GetData().size())
+    {
+      chunk.data_.GetData() = std::move(data);
+    }
+    else if (store_ != nullptr && store_->HasChunk(GetChunkPosition(key)))
+    {
+      utility::LogError("Failed to load chunk {},{} of world map!", GetChunkPosition(key).x, GetChunkPosition(key).y);
+    }
+
+    lru_list_.push_front(key);
+    chunk.lru_position_ = lru_list_.begin();
+    pending_loads_.erase(key);
+
+    return chunk;
+  }
+
+  void WorldMap::StreamChunks(const glm::ivec2& first_chunk, const glm::ivec2& last_chunk)
+  {
+    for (auto& [ chunk_position, data ] : store_->TakeLoadedChunks())
+    {
+      const uint64_t key = GetChunkKey(chunk_position);
+
+      // Chunks that were loaded immediately while queued, or cleared since, are already up to date.
+      if (pending_loads_.contains(key) && !chunks_.contains(key))
+      {
+        AddChunk(key, std::move(data));
+      }
+    }
+
+    for (int y = first_chunk.y; y <= last_chunk.y; ++y)
+    {
+      for (int x = first_chunk.x; x <= last_chunk.x; ++x)
+      {
+        const glm::ivec2 chunk_position = glm::ivec2(x, y);
+        const uint64_t key = GetChunkKey(chunk_position);
+
+        if (!chunks_.contains(key) && !pending_loads_.contains(key) && store_->HasChunk(chunk_position))
+        {
+          pending_loads_.insert(key);
+          store_->RequestLoad(chunk_position);
+        }
+      }
+    }
+  }
+
+  void WorldMap::EvictChunks(const glm::ivec2& first_chunk, const glm::ivec2& last_chunk)
+  {
+    static std::vector<uint64_t> evicted;
+
+    evicted.clear();
+
+    uint64_t memory_used = chunks_.size() * WORLD_CHUNK_BYTES;
+
+    for (auto it = lru_list_.rbegin(); it != lru_list_.rend() && memory_used > memory_budget_; ++it)
+    {
+      const glm::ivec2 chunk_position = GetChunkPosition(*it);
+
+      if (glm::all(glm::greaterThanEqual(chunk_position, first_chunk)) && glm::all(glm::lessThanEqual(chunk_position, last_chunk)))
+      {
+        continue;
+      }
+
+      evicted.push_back(*it);
+      memory_used -= WORLD_CHUNK_BYTES;
+    }
+
+    for (const uint64_t key : evicted)
+    {
+      WorldChunkList::iterator it = chunks_.find(key);
+
+      if (it->second.is_dirty_)
+      {
+        store_->Save(GetChunkPosition(key), it->second.data_.GetData());
+      }
+
+      lru_list_.erase(it->second.lru_position_);
+      chunks_.erase(it);
+    }
+  }
+}
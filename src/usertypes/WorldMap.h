@@ -0,0 +1,289 @@
+/// @author James Holtom
+
+#ifndef WORLD_MAP_H
+#define WORLD_MAP_H
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <glm/glm.hpp>
+#include "Character.h"
+#include "CharacterMap.h"
+#include "WorldChunkStore.h"
+
+namespace term_engine::usertypes {
+  class WorldMap;
+
+  /// @brief A chunk of characters in a world map.
+  struct WorldChunk {
+    /// @brief The characters in the chunk.
+    CharacterMap data_;
+    /// @brief Has the chunk changed since it was last loaded/saved?
+    bool is_dirty_;
+    /// @brief The position of the chunk in the world map's list of recently used chunks.
+    std::list<uint64_t>::iterator lru_position_;
+  };
+
+  /// @brief Unique pointer to a world map.
+  typedef std::unique_ptr<WorldMap> WorldMapPtr;
+  /// @brief Unique pointer to a world chunk store.
+  typedef std::unique_ptr<WorldChunkStore> WorldChunkStorePtr;
+  /// @brief Used to store the chunks of a world map, indexed by their chunk position.
+  typedef std::unordered_map<uint64_t, WorldChunk> WorldChunkList;
+
+  /// @brief The size of each chunk in a world map, in rows/columns.
+  constexpr glm::ivec2 WORLD_CHUNK_SIZE = glm::ivec2(32);
+  /// @brief The amount of memory used by each chunk in a world map, in bytes.
+  constexpr uint64_t WORLD_CHUNK_BYTES = sizeof(Character) * WORLD_CHUNK_SIZE.x * WORLD_CHUNK_SIZE.y;
+  /// @brief The default amount of memory that a streamed world map can keep chunks loaded in, in bytes.
+  constexpr uint64_t DEFAULT_WORLD_MAP_MEMORY_BUDGET = 64 * 1024 * 1024;
+  /// @brief The distance around the camera that chunks of a streamed world map are loaded in, in chunks.
+  constexpr int WORLD_MAP_STREAM_DISTANCE = 1;
+  /// @brief The depth that world maps are pushed to their game scene at, so that game objects on any layer are drawn above them.
+  constexpr int64_t WORLD_MAP_DEPTH = EMPTY_DEPTH + 1;
+
+  /// @brief Stores a large map of characters in fixed-size chunks, of which only the parts under the camera are drawn to a game scene.
+  class WorldMap {
+  public:
+    /**
+     * @brief Constructs the world map with the given size.
+     * 
+     * @param[in] size The size of the world map, in rows/columns.
+     */
+    WorldMap(const glm::ivec2& size);
+
+    /**
+     * @brief Constructs the world map, streaming its chunks to and from the given file.
+     * @details Chunks are loaded in the background as the camera approaches them, and the least recently used chunks are saved and unloaded when the memory budget is exceeded.
+     * 
+     * @param[in] filename The path to the world map file, relative to the project folder. The file is created if it does not exist.
+     * @param[in] size     The size of the world map, in rows/columns. If the file already exists, the size stored in the file is used instead.
+     */
+    WorldMap(const std::string& filename, const glm::ivec2& size);
+
+    /// @brief Destroys the world map, saving its chunks if it is streamed.
+    ~WorldMap();
+
+    /**
+     * @brief Returns the size of the world map.
+     * 
+     * @returns The size of the world map, in rows/columns.
+     */
+    glm::ivec2 GetSize() const;
+
+    /**
+     * @brief Returns the position of the camera, which is the top-left of the area drawn to the game scene.
+     * 
+     * @returns The camera position, in rows/columns.
+     */
+    glm::ivec2& GetCameraPosition();
+
+    /**
+     * @brief Returns the size of the camera, which matches the size of the game scene the world map was last drawn to.
+     * 
+     * @returns The camera size, in rows/columns.
+     */
+    glm::ivec2 GetCameraSize() const;
+
+    /**
+     * @brief Returns the number of chunks that are loaded.
+     * 
+     * @returns The number of loaded chunks.
+     */
+    size_t GetChunkCount() const;
+
+    /**
+     * @brief Returns if the world map's chunks are streamed to and from a file.
+     * 
+     * @returns If the world map is streamed.
+     */
+    bool IsStreamed() const;
+
+    /**
+     * @brief Returns the amount of memory that a streamed world map can keep chunks loaded in.
+     * 
+     * @returns The memory budget, in bytes.
+     */
+    uint64_t GetMemoryBudget() const;
+
+    /**
+     * @brief Returns the character at the given position.
+     * @note If the world map is streamed, and the chunk is not loaded, it is loaded before returning.
+     * 
+     * @param[in] rowcol The position in the world map, in rows/columns.
+     * @returns The character at the position, or an empty character if nothing has been set there.
+     */
+    Character GetCharacter(const glm::ivec2& rowcol);
+
+    /**
+     * @brief Sets the amount of memory that a streamed world map can keep chunks loaded in.
+     * @note Chunks under the camera are never unloaded, so the budget can be exceeded if the camera covers more chunks than it allows.
+     * 
+     * @param[in] budget The memory budget, in bytes.
+     */
+    void SetMemoryBudget(uint64_t budget);
+
+    /**
+     * @brief Sets the position of the camera.
+     * 
+     * @param[in] position The camera position, in rows/columns.
+     */
+    void SetCameraPosition(const glm::ivec2& position);
+
+    /**
+     * @brief Moves the camera so that the given position is in the center of it, without going past the edges of the world map.
+     * 
+     * @param[in] rowcol The position to center the camera on, in rows/columns.
+     */
+    void CenterCamera(const glm::ivec2& rowcol);
+
+    /**
+     * @brief Sets the character at the given position, allocating the chunk it belongs to if needed.
+     * 
+     * @param[in] rowcol    The position in the world map, in rows/columns.
+     * @param[in] character The character to set.
+     */
+    void SetCharacter(const glm::ivec2& rowcol, const Character& character);
+
+    /**
+     * @brief Sets every character in the given area.
+     * 
+     * @param[in] position  The top-left of the area to fill, in rows/columns.
+     * @param[in] size      The size of the area to fill, in rows/columns.
+     * @param[in] character The character to fill the area with.
+     */
+    void Fill(const glm::ivec2& position, const glm::ivec2& size, const Character& character);
+
+    /**
+     * @brief Copies a character map into the world map at the given position.
+     * 
+     * @param[in] position The position in the world map to copy the characters to, in rows/columns.
+     * @param[in] data     The character map to copy.
+     */
+    void PushCharacters(const glm::ivec2& position, CharacterMap& data);
+
+    /// @brief Removes all characters, and frees all chunks in the world map.
+    void Clear();
+
+    /// @brief Saves all changed chunks to the world map's file, if it is streamed.
+    void Save();
+
+    /**
+     * @brief Draws the chunks under the camera to the given character map.
+     * @details The camera is resized to match the character map. If the world map is streamed, chunks that have finished loading are added, chunks near the camera are queued to be loaded, and chunks are unloaded if the memory budget is exceeded.
+     * 
+     * @param[in,out] character_map The character map to draw to.
+     */
+    void Draw(CharacterMap* character_map);
+
+    /// @brief Updates the debugging information for this world map.
+    void UpdateDebugInfo() const;
+
+  protected:
+    /// @brief The size of the world map, in rows/columns.
+    glm::ivec2 size_;
+    /// @brief The position of the camera, in rows/columns.
+    glm::ivec2 camera_position_;
+    /// @brief The size of the camera, in rows/columns.
+    glm::ivec2 camera_size_;
+    /// @brief The chunks that are loaded.
+    WorldChunkList chunks_;
+    /// @brief The keys of the loaded chunks, from the most to the least recently used.
+    std::list<uint64_t> lru_list_;
+    /// @brief The file that chunks are streamed to and from, if the world map is streamed.
+    WorldChunkStorePtr store_;
+    /// @brief The keys of the chunks queued to be loaded.
+    std::unordered_set<uint64_t> pending_loads_;
+    /// @brief The amount of memory that a streamed world map can keep chunks loaded in, in bytes.
+    uint64_t memory_budget_;
+    /// @brief The number of chunks drawn to the game scene in the last frame.
+    size_t chunks_drawn_;
+
+    /**
+     * @brief Returns if the given position is inside the world map.
+     * 
+     * @param[in] rowcol The position to check, in rows/columns.
+     * @returns If the position is inside the world map.
+     */
+    bool IsInside(const glm::ivec2& rowcol) const;
+
+    /**
+     * @brief Returns the key used to index the chunk at the given chunk position.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns The chunk key.
+     */
+    static uint64_t GetChunkKey(const glm::ivec2& chunk_position);
+
+    /**
+     * @brief Returns the chunk position that the given key refers to.
+     * 
+     * @param[in] key The chunk key.
+     * @returns The position of the chunk, in chunks.
+     */
+    static glm::ivec2 GetChunkPosition(uint64_t key);
+
+    /**
+     * @brief Returns if the chunk at the given chunk position has any characters, whether it is loaded or not.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns If the chunk exists.
+     */
+    bool HasChunk(const glm::ivec2& chunk_position) const;
+
+    /**
+     * @brief Returns the chunk at the given chunk position, if it is loaded.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns A raw pointer to the chunk, or a null pointer if it is not loaded.
+     */
+    CharacterMap* GetChunk(const glm::ivec2& chunk_position);
+
+    /**
+     * @brief Returns the chunk at the given chunk position so that it can be modified, loading or allocating it if needed.
+     * @note The chunk is marked as changed, so that it is saved when unloaded.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns A raw pointer to the chunk.
+     */
+    CharacterMap* GetOrAddChunk(const glm::ivec2& chunk_position);
+
+    /**
+     * @brief Returns the chunk at the given chunk position, loading or allocating it if needed.
+     * @note The chunk isn't marked as changed, so reading from it doesn't cause it to be saved again.
+     * 
+     * @param[in] chunk_position The position of the chunk, in chunks.
+     * @returns A reference to the chunk.
+     */
+    WorldChunk& LoadChunk(const glm::ivec2& chunk_position);
+
+    /**
+     * @brief Adds a chunk to the list of loaded chunks.
+     * 
+     * @param[in] key  The chunk key.
+     * @param[in] data The character data of the chunk. If empty, the chunk is left blank.
+     * @returns A reference to the chunk.
+     */
+    WorldChunk& AddChunk(uint64_t key, CharacterData&& data);
+
+    /**
+     * @brief Adds the chunks that have finished loading, and queues the chunks in the given area to be loaded.
+     * 
+     * @param[in] first_chunk The top-left chunk of the area to load, in chunks.
+     * @param[in] last_chunk  The bottom-right chunk of the area to load, in chunks.
+     */
+    void StreamChunks(const glm::ivec2& first_chunk, const glm::ivec2& last_chunk);
+
+    /**
+     * @brief Saves and unloads the least recently used chunks outside of the given area, until the memory budget is met.
+     * 
+     * @param[in] first_chunk The top-left chunk of the area to keep loaded, in chunks.
+     * @param[in] last_chunk  The bottom-right chunk of the area to keep loaded, in chunks.
+     */
+    void EvictChunks(const glm::ivec2& first_chunk, const glm::ivec2& last_chunk);
+  };
+}
+
+#endif // ! WORLD_MAP_H
@@ -1,21 +1,30 @@
 #include "BaseObject.h"
 #include "GameObject.h"
+#include "TimedFunction.h"
 #include "../../utility/ImGuiUtils.h"
 
 namespace term_engine::usertypes {
-  uint64_t BaseObject::object_next_id_ = 1;
-
-  BaseObject::BaseObject() :
+  BaseObject::BaseObject(ObjectType type, uint64_t id) :
     Flaggable(),
-    object_id_(object_next_id_++),
+    object_type_(type),
+    object_id_(id),
     is_active_(true)
   {}
 
-  BaseObject::BaseObject(BaseObject* object) :
-    Flaggable(),
-    object_id_(object_next_id_++),
-    is_active_(object->is_active_)
-  {}
+  ObjectType BaseObject::GetObjectType() const
+  {
+    return object_type_;
+  }
+
+  std::string BaseObject::GetObjectTypeName() const
+  {
+    switch (object_type_)
+    {
+      case ObjectType::GAME_OBJECT:     return std::string(GAME_OBJECT_TYPE);
+      case ObjectType::TIMED_FUNCTION:  return std::string(TIMED_FUNCTION_TYPE);
+      default:                          return "";
+    }
+  }
 
   uint64_t BaseObject::GetObjectId() const
   {
@@ -32,57 +41,37 @@ namespace term_engine::usertypes {
     is_active_ = flag;
   }
 
-  uint64_t BaseObject::GetNextId()
-  {
-    return object_next_id_;
-  }
-
-  void SortObjects()
+  BaseObject* GetObjectById(uint64_t id)
   {
-    if (is_object_list_dirty)
+    // The type of object is stored in the ID's tag, so only the list for that type needs checking.
+    switch (static_cast<ObjectType>(utility::GetSlotHandleTag(id)))
     {
-      object_list.sort([](const ObjectPtr& lhs, const ObjectPtr& rhs) {
-        bool result = lhs->GetListPriority() <= rhs->GetListPriority();
-
-        if (lhs->GetObjectType() == std::string(GAME_OBJECT_TYPE) && rhs->GetObjectType() == std::string(GAME_OBJECT_TYPE))
-        {
-          GameObject* l_ptr = static_cast<GameObject*>(lhs.get());
-          GameObject* r_ptr = static_cast<GameObject*>(rhs.get());
-
-          result = result && l_ptr->GetLayer() <= r_ptr->GetLayer();
-        }
-        else
-        {
-          result = result && lhs->GetObjectId() < rhs->GetObjectId();
-        }
-
-        return result;
-      });
-
-      is_object_list_dirty = false;
+      case ObjectType::GAME_OBJECT:     return GetGameObjectById(id);
+      case ObjectType::TIMED_FUNCTION:  return GetTimedFunctionById(id);
+      default:                          return nullptr;
     }
   }
 
   void UpdateObjects(uint64_t timestep) 
   {
-    for (ObjectPtr& object : object_list)
-    {
-      object->Update(timestep);
-    }
+    UpdateTimedFunctions(timestep);
+    UpdateGameScenes(timestep);
   }
 
-  void ClearFlaggedObjects()
+  void ClearAllObjects()
   {
-    object_list.remove_if([](const ObjectPtr& object)
+    timed_function_list.Clear();
+    timed_function_wheel.Clear();
+    timed_function_remainder = 0;
+
+    for (auto& [ _, game_scene ] : game_scene_list)
     {
-      return object->FlaggedForRemoval();
-    });
-  }
+      game_scene->ClearGameObjects();
+    }
 
-  void ClearAllObjects()
-  {
-    object_list.clear();
+    ClearGameObjectPool();
+    tag_index.Clear();
 
     utility::LogDebug("Cleared all game objects from the list.");
   }
-}
\ No newline at end of file
+}
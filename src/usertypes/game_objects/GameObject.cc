@@ -1,99 +1,93 @@
+#include <algorithm>
+#include <cinttypes>
 #include <sstream>
+#include <vector>
 #include "GameObject.h"
-#include "../../events/InputManager.h"
 #include "../../events/Listener.h"
 #include "../../scripting/ScriptingInterface.h"
-#include "../../utility/ConversionUtils.h"
 #include "../../utility/ImGuiUtils.h"
 #include "../../utility/LogUtils.h"
 
 namespace term_engine::usertypes {
-  GameObject::GameObject(GameScene* game_scene, const glm::ivec2& position, const glm::ivec2& size) :
-    BaseObject(),
+  GameObject::GameObject() :
+    BaseObject(ObjectType::GAME_OBJECT, utility::NULL_SLOT_HANDLE),
     layer_(0),
+    creation_sequence_(0),
     is_hovering_(false),
-    position_(position),
-    game_scene_(game_scene)
-  {
-    data_.SetSize(size);
-
-    utility::LogDebug("Created object with ID {} at {},{} with size {}x{}.", object_id_, position.x, position.y, size.x, size.y);
-  }
-
-  GameObject::GameObject(GameScene* game_scene, GameObject* object) :
-    BaseObject(object),
-    layer_(object->layer_),
-    is_hovering_(false),
-    position_(object->position_),
-    data_(object->data_),
-    game_scene_(game_scene)
-  {
-    utility::LogDebug("Copied object with ID {} to ID {}.", object->object_id_, object_id_);
-  }
+    is_culled_(false),
+    is_indexed_(false),
+    indexed_position_(0),
+    indexed_size_(0),
+    position_(0),
+    game_scene_(nullptr),
+    scene_index_(0),
+    tags_(),
+    components_(),
+    collision_mode_(CollisionMode::NO_COLLISION)
+  {}
 
   GameObject::~GameObject()
   {
-    utility::LogDebug("Destroyed object with ID {}.", object_id_);
+    if (game_scene_ != nullptr)
+    {
+      Detach();
+    }
   }
 
-  void GameObject::Update(uint64_t timestep)
+  void GameObject::Spawn(GameScene* game_scene, const glm::ivec2& position, const glm::ivec2& size)
   {
-    if (is_active_ && game_scene_->GetGameWindow() != nullptr)
+    // A pooled object's map keeps the settings of its previous owner, so restore the defaults of a new map.
+    data_.SetHideEmptyCharacters(true);
+    data_.SetDepthTest(false);
+
+    // Blank the existing character data if it is already the right size, rather than allocating new data.
+    if (data_.GetSize() == size)
     {
-      GameWindow* game_window = game_scene_->GetGameWindow();
-      glm::ivec2 mouse_position = events::GetMousePosition();
-      glm::ivec2 mouse_rowcol = utility::GetRowColFromPosition(game_scene_->GetGameWindow(), mouse_position);
+      data_.Clear();
+    }
+    else
+    {
+      data_.SetSize(size);
+    }
 
-      if (game_window->GetWindow()->IsInFocus() && glm::all(glm::greaterThanEqual(mouse_rowcol, position_)) && glm::all(glm::lessThanEqual(mouse_rowcol, position_ + data_.GetSize() - glm::ivec2(1))))
-      {
-        if (!is_hovering_)
-        {
-          is_hovering_ = true;
-          events::Event ev = events::event_list.emplace_back("object_hover", game_window, scripting::lua_state->create_table_with(
-            "game_scene", game_scene_->GetName(),
-            "id", object_id_,
-            "type", "over"
-          ));
-        }
-      }
-      else
-      {
-        if (is_hovering_)
-        {
-          is_hovering_ = false;
-          
-          events::event_list.emplace_back("object_hover", game_window, scripting::lua_state->create_table_with(
-            "game_scene", game_scene_->GetName(),
-            "id", object_id_,
-            "type", "out"
-          ));
-        }
-      }
+    layer_ = 0;
+    is_active_ = true;
+    collision_mode_ = CollisionMode::NO_COLLISION;
+    position_ = position;
+    animation_state_ = AnimationState();
 
-      if (animation_state_.HasAnimationsQueued())
-      {
-        animation_state_.Update(timestep);
+    Attach(game_scene);
+  }
 
-        AnimationFrame* frame = animation_state_.GetCurrentFrame();
-        assert(frame != nullptr);
+  void GameObject::Spawn(GameScene* game_scene, GameObject* object, const glm::ivec2& position)
+  {
+    // The character data is shared with the other object, until either of them is modified.
+    data_ = object->data_;
+    layer_ = object->layer_;
+    is_active_ = object->is_active_;
+    tags_ = object->tags_;
+    components_ = object->components_;
+    collision_mode_ = object->collision_mode_;
+    position_ = position;
+    animation_state_ = AnimationState();
 
-        game_scene_->GetCharacterMap()->PushCharacters(position_ + frame->GetOffset(), frame->GetCharacterMap());
-      }
-      else
-      {
-        game_scene_->GetCharacterMap()->PushCharacters(position_, data_);
-      }
-    }
+    Attach(game_scene);
   }
 
-  std::string GameObject::GetObjectType() const
+  void GameObject::Update(uint64_t timestep)
   {
-    return std::string(GAME_OBJECT_TYPE);
+    if (is_active_ && game_scene_ != nullptr && game_scene_->GetGameWindow() != nullptr && animation_state_.HasAnimationsQueued())
+    {
+      animation_state_.Update(timestep);
+    }
   }
 
-  ObjectSortPriority GameObject::GetListPriority() const
+  void GameObject::Draw(CharacterMapDrawList& draw_list)
   {
-    return ObjectSortPriority::OBJECT;
+    if (is_active_ && !is_culled_ && game_scene_ != nullptr && game_scene_->GetGameWindow() != nullptr)
+    {
+      draw_list.push_back({ GetDrawnPosition() - game_scene_->GetCameraPosition(), &GetDrawnCharacterMap(), GetDepth() });
+    }
   }
 
   GameScene* GameObject::GetGameScene() const
@@ -101,16 +95,59 @@ namespace term_engine::usertypes {
     return game_scene_;
   }
 
+  size_t GameObject::GetSceneIndex() const
+  {
+    return scene_index_;
+  }
+
   int32_t GameObject::GetLayer() const
   {
     return layer_;
   }
 
+  int64_t GameObject::GetDepth() const
+  {
+    return ((int64_t)layer_ << 32) | creation_sequence_;
+  }
+
   bool GameObject::IsHoveringOver() const
   {
     return is_hovering_;
   }
 
+  bool GameObject::IsCulled() const
+  {
+    return is_culled_;
+  }
+
+  glm::ivec2 GameObject::GetDrawnPosition()
+  {
+    AnimationFrame* frame = animation_state_.GetCurrentFrame();
+
+    return frame != nullptr ? position_ + frame->GetOffset() : position_;
+  }
+
+  CharacterMap& GameObject::GetDrawnCharacterMap()
+  {
+    AnimationFrame* frame = animation_state_.GetCurrentFrame();
+
+    return frame != nullptr ? frame->GetCharacterMap() : data_;
+  }
+
+  bool GameObject::IsInsideGameScene()
+  {
+    if (game_scene_ == nullptr)
+    {
+      return false;
+    }
+
+    const glm::ivec2 position = GetDrawnPosition() - game_scene_->GetCameraPosition();
+    const glm::ivec2 size = GetDrawnCharacterMap().GetSize();
+    const glm::ivec2 scene_size = game_scene_->GetCharacterMap()->GetSize();
+
+    return glm::all(glm::greaterThan(position + size, glm::ivec2(0))) && glm::all(glm::lessThan(position, scene_size));
+  }
+
   glm::ivec2& GameObject::GetPosition()
   {
     return position_;
@@ -126,16 +163,69 @@ namespace term_engine::usertypes {
     return animation_state_;
   }
 
+  void GameObject::SetSceneIndex(size_t index)
+  {
+    scene_index_ = index;
+  }
+
   void GameObject::SetLayer(int32_t layer)
   {
-    layer_ = layer;
+    if (layer == layer_)
+    {
+      return;
+    }
 
-    is_object_list_dirty = true;
+    if (game_scene_ == nullptr)
+    {
+      layer_ = layer;
+
+      return;
+    }
+
+    // Re-key the existing node, rather than erasing and inserting the object again.
+    GameObjectDrawOrder& draw_order = game_scene_->GetDrawOrder();
+    auto node = draw_order.extract(GetDepth());
+    layer_ = layer;
+    node.key() = GetDepth();
+    draw_order.insert(std::move(node));
   }
 
   void GameObject::SetPosition(const glm::ivec2& position)
   {
     position_ = position;
+
+    UpdateIndex();
+  }
+
+  void GameObject::SetHovering(bool flag)
+  {
+    if (is_hovering_ == flag)
+    {
+      return;
+    }
+
+    is_hovering_ = flag;
+
+    if (game_scene_ == nullptr)
+    {
+      return;
+    }
+
+    GameWindow* game_window = game_scene_->GetGameWindow();
+
+    if (game_window != nullptr)
+    {
+      events::event_list.emplace_back("object_hover", game_window, scripting::lua_state->create_table_with(
+        "game_scene", game_scene_->GetName(),
+        "id", object_id_,
+        "type", flag ? "over" : "out"
+      ));
+    }
+  }
+
+  void GameObject::SetCulled(bool flag)
+  {
+    is_culled_ = flag;
   }
 
   void GameObject::SetCharacterMap(const CharacterMap& data)
@@ -156,16 +246,28 @@ namespace term_engine::usertypes {
     {
       utility::LogWarn("Cannot move game object to non-existent game scene \"{}\"!", name);
     }
+    else if (game_scene_ == nullptr)
+    {
+      utility::LogWarn("Cannot move game object with ID {}, as it has been released!", object_id_);
+    }
     else
     {
+      SetHovering(false);
+
+      // The old game scene owns this object, so take it from the scene before moving it.
+      GameObjectPtr game_object = game_scene_->ReleaseGameObject(this);
+      game_scene_->GetDrawOrder().erase(GetDepth());
+      RemoveFromIndex();
+
       game_scene_ = game_scene;
+      game_scene_->GetDrawOrder().emplace(GetDepth(), this);
+      UpdateIndex();
+      game_scene_->AddGameObject(std::move(game_object));
     }
   }
 
   GameObject* GameObject::CopyToGameScene(const std::string& name)
   {
-    is_object_list_dirty = true;
-
     GameScene* game_scene = GetGameSceneByName(name);
 
     if (game_scene == nullptr)
@@ -176,21 +278,290 @@ namespace term_engine::usertypes {
     }
     else
     {
-      object_list.emplace_front(std::make_shared<GameObject>(game_scene, this));
+      GameObjectPtr game_object = AcquireGameObject();
+      game_object->Spawn(game_scene, this, position_);
+
+      utility::LogDebug("Copied object with ID {} to ID {}.", object_id_, game_object->GetObjectId());
+
+      return game_scene->AddGameObject(std::move(game_object));
+    }
+  }
+
+  const TagMask& GameObject::GetTags() const
+  {
+    return tags_;
+  }
+
+  std::vector<std::string> GameObject::GetTagNames() const
+  {
+    std::vector<std::string> names;
+
+    for (size_t tag_id = 0; tag_id < tag_index.GetTagCount(); ++tag_id)
+    {
+      if (tags_.test(tag_id))
+      {
+        names.push_back(tag_index.GetTagName(tag_id));
+      }
+    }
+
+    return names;
+  }
+
+  bool GameObject::HasTag(const std::string& name) const
+  {
+    const size_t tag_id = tag_index.GetTagId(name);
+
+    return tag_id != NULL_TAG_ID && tags_.test(tag_id);
+  }
+
+  void GameObject::AddTag(const std::string& name)
+  {
+    const size_t tag_id = tag_index.GetOrAddTagId(name);
+
+    if (tag_id != NULL_TAG_ID)
+    {
+      SetTag(tag_id, true);
+    }
+  }
+
+  void GameObject::RemoveTag(const std::string& name)
+  {
+    const size_t tag_id = tag_index.GetTagId(name);
+
+    if (tag_id == NULL_TAG_ID)
+    {
+      return;
+    }
+
+    SetTag(tag_id, false);
 
-      return static_cast<GameObject*>(object_list.front().get());
+    GameObjectComponentList::iterator it = std::find_if(components_.begin(), components_.end(), [&tag_id](const GameObjectComponent& component) { return component.tag_id_ == tag_id; });
+
+    if (it != components_.end())
+    {
+      *it = std::move(components_.back());
+      components_.pop_back();
+    }
+  }
+
+  sol::object GameObject::GetComponent(const std::string& name) const
+  {
+    const size_t tag_id = tag_index.GetTagId(name);
+
+    for (const GameObjectComponent& component : components_)
+    {
+      if (component.tag_id_ == tag_id)
+      {
+        return component.value_;
+      }
+    }
+
+    return sol::lua_nil;
+  }
+
+  void GameObject::SetComponent(const std::string& name, const sol::object& value)
+  {
+    if (!value.valid() || value.get_type() == sol::type::lua_nil)
+    {
+      RemoveTag(name);
+
+      return;
+    }
+
+    const size_t tag_id = tag_index.GetOrAddTagId(name);
+
+    if (tag_id == NULL_TAG_ID)
+    {
+      utility::LogWarn("Cannot set component \"{}\" on game object with ID {}, as its name needs a tag ID and there are none left.", name, object_id_);
+
+      return;
+    }
+
+    SetTag(tag_id, true);
+
+    for (GameObjectComponent& component : components_)
+    {
+      if (component.tag_id_ == tag_id)
+      {
+        component.value_ = value;
+
+        return;
+      }
+    }
+
+    components_.push_back({ tag_id, value });
+  }
+
+  void GameObject::SetTag(size_t tag_id, bool flag)
+  {
+    if (tags_.test(tag_id) == flag)
+    {
+      return;
+    }
+
+    tags_.set(tag_id, flag);
+
+    // Released objects aren't in any tag sets, so only the mask is changed.
+    if (game_scene_ == nullptr)
+    {
+      return;
+    }
+
+    if (flag)
+    {
+      tag_index.GetTagSet(tag_id).Insert(this);
+    }
+    else
+    {
+      tag_index.GetTagSet(tag_id).Remove(this);
+    }
+  }
+
+  CollisionMode GameObject::GetCollisionMode() const
+  {
+    return collision_mode_;
+  }
+
+  void GameObject::SetCollisionMode(CollisionMode mode)
+  {
+    collision_mode_ = mode;
+  }
+
+  bool GameObject::CollidesWith(GameObject& other)
+  {
+    if (collision_mode_ != CollisionMode::CELL_COLLISION && other.collision_mode_ != CollisionMode::CELL_COLLISION)
+    {
+      return true;
+    }
+
+    const glm::ivec2 position = GetDrawnPosition();
+    const glm::ivec2 other_position = other.GetDrawnPosition();
+    CharacterMap& data = GetDrawnCharacterMap();
+    CharacterMap& other_data = other.GetDrawnCharacterMap();
+    const glm::ivec2 first = glm::max(position, other_position);
+    const glm::ivec2 last = glm::min(position + data.GetSize(), other_position + other_data.GetSize());
+
+    // Only the overlapping area is checked, and the characters are read without un-sharing either object's character data.
+    for (int y = first.y; y < last.y; ++y)
+    {
+      for (int x = first.x; x < last.x; ++x)
+      {
+        const glm::ivec2 rowcol(x, y);
+        const bool is_solid = collision_mode_ != CollisionMode::CELL_COLLISION || data.GetCharacter(rowcol - position).character_ != NO_CHARACTER;
+        const bool is_other_solid = other.collision_mode_ != CollisionMode::CELL_COLLISION || other_data.GetCharacter(rowcol - other_position).character_ != NO_CHARACTER;
+
+        if (is_solid && is_other_solid)
+        {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void GameObject::UpdateIndex()
+  {
+    if (game_scene_ == nullptr)
+    {
+      return;
+    }
+
+    const glm::ivec2 position = GetDrawnPosition();
+    const glm::ivec2 size = GetDrawnCharacterMap().GetSize();
+
+    if (is_indexed_ && position == indexed_position_ && size == indexed_size_)
+    {
+      return;
+    }
+
+    SpatialGrid* spatial_grid = game_scene_->GetSpatialGrid();
+
+    if (is_indexed_)
+    {
+      spatial_grid->Remove(this, indexed_position_, indexed_size_);
+    }
+
+    spatial_grid->Insert(this, position, size);
+    is_indexed_ = true;
+    indexed_position_ = position;
+    indexed_size_ = size;
+  }
+
+  void GameObject::RemoveFromIndex()
+  {
+    if (is_indexed_)
+    {
+      game_scene_->GetSpatialGrid()->Remove(this, indexed_position_, indexed_size_);
+      is_indexed_ = false;
+    }
+  }
+
+  void GameObject::Attach(GameScene* game_scene)
+  {
+    object_id_ = game_object_ids.Insert(this);
+    creation_sequence_ = next_creation_sequence++;
+    game_scene_ = game_scene;
+    is_hovering_ = false;
+    is_culled_ = false;
+    UnflagForRemoval();
+
+    game_scene_->GetDrawOrder().emplace(GetDepth(), this);
+    UpdateIndex();
+
+    for (size_t tag_id = 0; tag_id < tag_index.GetTagCount(); ++tag_id)
+    {
+      if (tags_.test(tag_id))
+      {
+        tag_index.GetTagSet(tag_id).Insert(this);
+      }
+    }
+  }
+
+  void GameObject::Detach()
+  {
+    game_scene_->GetDrawOrder().erase(GetDepth());
+    RemoveFromIndex();
+
+    // The tag sets are looked up by the object's ID, so remove the object from them before the ID is released.
+    for (size_t tag_id = 0; tag_id < tag_index.GetTagCount(); ++tag_id)
+    {
+      if (tags_.test(tag_id))
+      {
+        tag_index.GetTagSet(tag_id).Remove(this);
+      }
+    }
+
+    tags_.reset();
+    components_.clear();
+    game_object_ids.Remove(object_id_);
+
+    object_id_ = utility::NULL_SLOT_HANDLE;
+    game_scene_ = nullptr;
+  }
+
+  void GameObject::Remove()
+  {
+    // Objects in the object pool don't belong to a game scene, and can still be released from a script that holds onto them.
+    if (game_scene_ != nullptr)
+    {
+      RecycleGameObject(game_scene_->ReleaseGameObject(this));
     }
   }
 
   void GameObject::UpdateDebugInfo() const
   {
-    if (ImGui::TreeNode((void*)this, "%s #%li", GetObjectType().c_str(), object_id_))
+    if (ImGui::TreeNode((void*)this, "%s #%" PRIu64, GetObjectTypeName().c_str(), object_id_))
     {
-      ImGui::Text("ID: %lu", object_id_);
+      ImGui::Text("ID: %" PRIu64, object_id_);
       ImGui::Text("Active?: %s", is_active_ ? "Yes" : "No");
       ImGui::Text("Hovering?: %s", is_hovering_ ? "Yes" : "No");
+      ImGui::Text("Culled?: %s", is_culled_ ? "Yes" : "No");
       ImGui::Text("Position: %i, %i", position_.x, position_.y);
-      ImGui::Text("Game Scene: %s", game_scene_->GetName().c_str());
+      ImGui::Text("Game Scene: %s", game_scene_ != nullptr ? game_scene_->GetName().c_str() : "None");
+      ImGui::Text("Tags: %zu", tags_.count());
+      ImGui::Text("Components: %zu", components_.size());
+      ImGui::Text("Collision Mode: %i", collision_mode_);
 
       data_.UpdateDebugInfo();
       animation_state_.UpdateDebugInfo();
@@ -199,6 +570,39 @@ namespace term_engine::usertypes {
     }
   }
 
+  GameObjectRef::GameObjectRef(GameObject* game_object) :
+    object_id_(game_object->GetObjectId())
+  {}
+
+  uint64_t GameObjectRef::GetObjectId() const
+  {
+    return object_id_;
+  }
+
+  GameObject* GameObjectRef::Get() const
+  {
+    GameObject** game_object = game_object_ids.Get(object_id_);
+
+    return game_object != nullptr ? *game_object : nullptr;
+  }
+
+  GameObject& GameObjectRef::GetChecked() const
+  {
+    GameObject* game_object = Get();
+
+    if (game_object == nullptr)
+    {
+      throw sol::error("Cannot use game object with ID " + std::to_string(object_id_) + ", as it has been released!");
+    }
+
+    return *game_object;
+  }
+
+  bool GameObjectRef::operator==(const GameObjectRef& other) const
+  {
+    return object_id_ == other.object_id_;
+  }
+
   GameObject* AddGameObjectToScene(const glm::ivec2& position, const glm::ivec2& size, GameSceneVariant game_scene)
   {
     if (size.x <= 0 || size.y <= 0)
@@ -234,11 +638,12 @@ namespace term_engine::usertypes {
     }
     else
     {
-      is_object_list_dirty = true;
+      GameObjectPtr game_object = AcquireGameObject();
+      game_object->Spawn(find_scene, position, size);
 
-      object_list.emplace_front(std::make_shared<GameObject>(find_scene, position, size));
-      
-      return static_cast<GameObject*>(object_list.front().get());
+      utility::LogDebug("Created object with ID {} at {},{} with size {}x{}.", game_object->GetObjectId(), position.x, position.y, size.x, size.y);
+
+      return find_scene->AddGameObject(std::move(game_object));
     }
   }
 
@@ -247,37 +652,121 @@ namespace term_engine::usertypes {
     return AddGameObjectToScene(position, size, "default");
   }
 
-  void ClearGameObjectsByGameScene(const std::string& name)
+  std::vector<GameObject*> SpawnGameObjects(GameObject* object, const sol::table& positions)
   {
-    GameScene* game_scene = GetGameSceneByName(name);
+    std::vector<GameObject*> game_objects;
+
+    if (object == nullptr || object->GetGameScene() == nullptr)
+    {
+      utility::LogWarn("Cannot spawn game objects from a released game object!");
+
+      return game_objects;
+    }
+
+    GameScene* game_scene = object->GetGameScene();
+    game_objects.reserve(positions.size());
+
+    for (size_t index = 1; index <= positions.size(); ++index)
+    {
+      sol::optional<glm::ivec2> position = positions[index];
+
+      if (!position)
+      {
+        utility::LogWarn("Cannot spawn game object at invalid position #{}!", index);
+
+        continue;
+      }
+
+      GameObjectPtr game_object = AcquireGameObject();
+      game_object->Spawn(game_scene, object, *position);
+      game_objects.push_back(game_scene->AddGameObject(std::move(game_object)));
+    }
+
+    utility::LogDebug("Spawned {} copies of object with ID {}.", game_objects.size(), object->GetObjectId());
+
+    return game_objects;
+  }
+
+  GameObjectPtr AcquireGameObject()
+  {
+    if (game_object_pool.empty())
+    {
+      return std::make_unique<GameObject>();
+    }
+
+    GameObjectPtr game_object = std::move(game_object_pool.back());
+    game_object_pool.pop_back();
+
+    return game_object;
+  }
+
+  void RecycleGameObject(GameObjectPtr&& game_object)
+  {
+    if (game_object_pool.size() < game_object_pool_size)
+    {
+      game_object->Detach();
+      game_object_pool.push_back(std::move(game_object));
+    }
+    else
+    {
+      game_object.reset();
+    }
+  }
+
+  void ReserveGameObjects(size_t count)
+  {
+    game_object_pool_size = std::max(game_object_pool_size, count);
+    game_object_pool.reserve(game_object_pool_size);
 
-    object_list.remove_if([&game_scene](const ObjectPtr& object)
+    while (game_object_pool.size() < count)
     {
-      return object->GetObjectType() == std::string(GAME_OBJECT_TYPE) && dynamic_cast<GameObject*>(object.get())->GetGameScene() == game_scene;
-    });
+      game_object_pool.push_back(std::make_unique<GameObject>());
+    }
+  }
 
-    utility::LogDebug("Cleared all game objects for game scene \"{}\" from the list.", name);
+  void ClearGameObjectPool()
+  {
+    game_object_pool.clear();
+    game_object_pool_size = DEFAULT_GAME_OBJECT_POOL_SIZE;
   }
 
   GameObject* GetGameObjectById(uint64_t id)
   {
-    for (auto& object : object_list)
+    GameObject** game_object = game_object_ids.Get(id);
+
+    if (game_object == nullptr)
     {
-      if (object->GetObjectId() == id)
+      if (utility::GetSlotHandleTag(id) != game_object_ids.GetTag())
       {
-        if (object->GetObjectType() == std::string(GAME_OBJECT_TYPE))
-        {
-          return static_cast<GameObject*>(object.get());
-        }
+        utility::LogWarn("Object with ID {} is not a game object.", id);
       }
-      else
-      {
-        utility::LogWarn("Object with ID {} is the name of a(n) {}.", id, object->GetObjectType());
 
-        return nullptr;
-      }
+      return nullptr;
+    }
+
+    return *game_object;
+  }
+
+  sol::optional<GameObjectRef> MakeGameObjectRef(GameObject* game_object)
+  {
+    if (game_object == nullptr)
+    {
+      return sol::nullopt;
+    }
+
+    return GameObjectRef(game_object);
+  }
+
+  GameObjectRefList MakeGameObjectRefs(const std::vector<GameObject*>& game_objects)
+  {
+    GameObjectRefList refs;
+    refs.reserve(game_objects.size());
+
+    for (GameObject* game_object : game_objects)
+    {
+      refs.emplace_back(game_object);
     }
 
-    return nullptr;
+    return refs;
   }
 }
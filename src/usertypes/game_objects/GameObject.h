@@ -3,70 +3,113 @@
 #ifndef GAME_OBJECT_H
 #define GAME_OBJECT_H
 
+#include <memory>
 #include <string>
+#include <vector>
 #include "BaseObject.h"
+#include "TagIndex.h"
 #include "../Character.h"
 #include "../CharacterMap.h"
 #include "../GameScene.h"
 #include "../resources/Animation.h"
 #include "../../utility/GLUtils.h"
+#include "../../utility/SlotMap.h"
 #include "../../utility/SolUtils.h"
 
 namespace term_engine::usertypes {
+  class GameObject;
+
+  /// @brief Used to look up game objects by their ID. The objects themselves are owned by their game scene.
+  typedef utility::SlotMap<GameObject*> GameObjectIdList;
+
+  /// @brief A user-defined value attached to a game object, which is named by a tag.
+  struct GameObjectComponent {
+    /// @brief The ID of the tag naming the component.
+    size_t tag_id_;
+    /// @brief The value of the component.
+    sol::object value_;
+  };
+
+  /// @brief Used to store the components of a game object.
+  typedef std::vector<GameObjectComponent> GameObjectComponentList;
+
+  /// @brief Defines how a game object collides with other game objects. Objects collide by cell when either of them has _CELL_COLLISION_ set.
+  enum CollisionMode { NO_COLLISION = 0, RECT_COLLISION = 1, CELL_COLLISION = 2 };
+
   /// @brief The type name for GameObjects.
   constexpr char GAME_OBJECT_TYPE[] = "GameObject";
 
+  /// @brief The default number of released game objects that are kept for reuse.
+  constexpr size_t DEFAULT_GAME_OBJECT_POOL_SIZE = 1024;
+
+  /// @brief The number of game objects drawn in the last frame.
+  inline uint64_t objects_drawn = 0;
+  /// @brief The number of game objects culled from drawing in the last frame.
+  inline uint64_t objects_culled = 0;
+
   /// @brief Used to represent a game object, that is rendered to the screen.
-  class GameObject : public BaseObject {
+  class GameObject final : public BaseObject {
   public:
+    /// @brief Constructs the object, without adding it to a game scene.
+    GameObject();
+
+    /// @brief Destroys the object, removing it from its game scene if it is in one.
+    ~GameObject();
+
     /**
-     * @brief Constructs the object with the given parameters.
+     * @brief Adds the object to a game scene with blank character data, giving it a new ID.
+     * @note The object's existing character data is reused if it is already the right size, and the map's settings are reset to those of a new map.
      * 
      * @param[in] game_scene The game scene the object belongs to.
      * @param[in] position   The position of the object in the window.
      * @param[in] size       The size of the object, i.e. how many rows & columns.
      */
-    GameObject(GameScene* game_scene, const glm::ivec2& position, const glm::ivec2& size);
+    void Spawn(GameScene* game_scene, const glm::ivec2& position, const glm::ivec2& size);
 
     /**
-     * @brief Copy-constructs the object from an existing object.
+     * @brief Adds the object to a game scene as a copy of an existing object, giving it a new ID.
+     * @note The character data is shared with the other object until either of them is modified, so no character data is allocated.
      * 
-     * @param[in] game_scene  The game scene the object belongs to.
-     * @param[in] object      The object to copy from.
+     * @param[in] game_scene The game scene the object belongs to.
+     * @param[in] object     The object to copy from.
+     * @param[in] position   The position of the object in the window.
      */
-    GameObject(GameScene* game_scene, GameObject* object);
+    void Spawn(GameScene* game_scene, GameObject* object, const glm::ivec2& position);
 
-    /// @brief Destroys the object.
-    ~GameObject();
+    /// @brief Removes the object from its game scene and releases its ID, so that it can be kept in the object pool.
+    void Detach();
+
+    /// @brief Releases the object from its game scene into the object pool.
+    void Remove();
 
     /**
-     * @brief Updates the object.
+     * @brief Updates the object's animation.
+     * @note This is called from the job system's workers, so it must not call into Lua or change anything outside of the object.
      * 
-     * @param[in] timestep The time since the last update, in milliseconds (ms).
+     * @param[in] timestep The time since the last update, in nanoseconds (ns).
      */
     void Update(uint64_t timestep);
 
     /**
-     * @brief Returns the type of the object.
+     * @brief Adds the object to the list of character maps to draw to its game scene, unless it has been culled.
      * 
-     * @returns The object type.
+     * @param[in] draw_list The list of character maps to draw to the game scene.
      */
-    std::string GetObjectType() const;
+    void Draw(CharacterMapDrawList& draw_list);
 
     /**
-     * @brief Returns the list priority for this object.
-     * @details This is used to sort the list of objects before updating.
+     * @brief Returns a raw pointer to the game scene this object belongs to.
      * 
-     * @returns The priority for this object.
+     * @returns The raw pointer to the game scene, or a null pointer if the object has been released.
      */
-    ObjectSortPriority GetListPriority() const;
+    GameScene* GetGameScene() const;
 
     /**
-     * @brief Returns a raw pointer to the game scene this object belongs to.
+     * @brief Returns the position of the object in its game scene's list of objects.
      * 
-     * @returns The raw pointer to the game scene.
+     * @returns The position in the game scene's list.
      */
-    GameScene* GetGameScene() const;
+    size_t GetSceneIndex() const;
 
     /**
      * @brief Returns the Z-layer this object occupies.
@@ -75,6 +118,14 @@ namespace term_engine::usertypes {
      */
     int32_t GetLayer() const;
 
+    /**
+     * @brief Returns the depth this object is drawn at.
+     * @details The depth is made up of the Z-layer, followed by the object's creation sequence number. Objects on the same layer are drawn in the order they were created.
+     * 
+     * @returns The depth this object is drawn at.
+     */
+    int64_t GetDepth() const;
+
     /**
      * @brief Returns if the mouse is currently hovering over the object.
      * 
@@ -82,6 +133,34 @@ namespace term_engine::usertypes {
      */
     bool IsHoveringOver() const;
 
+    /**
+     * @brief Returns if the object was culled from drawing in the last frame.
+     * 
+     * @returns If the object was culled.
+     */
+    bool IsCulled() const;
+
+    /**
+     * @brief Returns the position the object is drawn at, including the offset of the current animation frame.
+     * 
+     * @returns The position the object is drawn at.
+     */
+    glm::ivec2 GetDrawnPosition();
+
+    /**
+     * @brief Returns the character map that is drawn for the object, i.e. the current animation frame or the object's character data.
+     * 
+     * @returns The character map that is drawn.
+     */
+    CharacterMap& GetDrawnCharacterMap();
+
+    /**
+     * @brief Returns if any part of the object lies within its game scene's character map.
+     * 
+     * @returns If the object is inside its game scene, or false if the object has been released.
+     */
+    bool IsInsideGameScene();
+
     /**
      * @brief Returns the position of the object.
      * 
@@ -104,7 +183,15 @@ namespace term_engine::usertypes {
     AnimationState& GetAnimation();
 
     /**
-     * @brief Sets the Z-layer this object occupies.
+     * @brief Sets the position of the object in its game scene's list of objects.
+     * @note This is set by the game scene as objects are added and removed.
+     * 
+     * @param[in] index The position in the game scene's list.
+     */
+    void SetSceneIndex(size_t index);
+
+    /**
+     * @brief Sets the Z-layer this object occupies, and moves it to its new place in the draw order.
      * 
      * @param[in] layer The Z-layer to set.
      */
@@ -117,6 +204,21 @@ namespace term_engine::usertypes {
      */
     void SetPosition(const glm::ivec2& position);
 
+    /**
+     * @brief Sets if the mouse is hovering over the object, and sends an "object_hover" event if it has changed.
+     * @note This is set by the object's game scene, which only marks its top-most object under the mouse as hovered.
+     * 
+     * @param[in] flag If the mouse is hovering over the object.
+     */
+    void SetHovering(bool flag);
+
+    /**
+     * @brief Sets if the object is culled from drawing.
+     * 
+     * @param[in] flag If the object is culled.
+     */
+    void SetCulled(bool flag);
+
     /**
      * @brief Sets the character data for the object.
      * 
@@ -146,14 +248,106 @@ namespace term_engine::usertypes {
      */
     GameObject* CopyToGameScene(const std::string& name);
 
+    /**
+     * @brief Returns the tags the object has, including the names of its components.
+     * 
+     * @returns The tag mask.
+     */
+    const TagMask& GetTags() const;
+
+    /**
+     * @brief Returns the names of the tags the object has, including the names of its components.
+     * 
+     * @returns The list of tag names.
+     */
+    std::vector<std::string> GetTagNames() const;
+
+    /**
+     * @brief Returns if the object has the given tag, or a component with the given name.
+     * 
+     * @param[in] name The name of the tag.
+     * @returns If the object has the tag.
+     */
+    bool HasTag(const std::string& name) const;
+
+    /**
+     * @brief Gives the object the given tag.
+     * 
+     * @param[in] name The name of the tag.
+     */
+    void AddTag(const std::string& name);
+
+    /**
+     * @brief Takes the given tag from the object, along with the component of the same name.
+     * 
+     * @param[in] name The name of the tag.
+     */
+    void RemoveTag(const std::string& name);
+
+    /**
+     * @brief Returns the value of the given component.
+     * 
+     * @param[in] name The name of the component.
+     * @returns The component value, or _nil_ if the object doesn't have the component.
+     */
+    sol::object GetComponent(const std::string& name) const;
+
+    /**
+     * @brief Sets the value of the given component, and gives the object a tag of the same name.
+     * @note Setting a component to _nil_ removes it.
+     * 
+     * @param[in] name  The name of the component.
+     * @param[in] value The component value.
+     */
+    void SetComponent(const std::string& name, const sol::object& value);
+
+    /**
+     * @brief Returns how the object collides with other objects.
+     * 
+     * @returns The collision mode.
+     */
+    CollisionMode GetCollisionMode() const;
+
+    /**
+     * @brief Sets how the object collides with other objects.
+     * 
+     * @param[in] mode The collision mode.
+     */
+    void SetCollisionMode(CollisionMode mode);
+
+    /**
+     * @brief Returns if the object collides with another object whose area overlaps it.
+     * @details Objects colliding by rectangle always collide when they overlap. Objects colliding by cell only collide where there are non-empty characters in both objects, or the other object collides by rectangle.
+     * 
+     * @param[in] other The other object, which must overlap this object.
+     * @returns If the objects collide.
+     */
+    bool CollidesWith(GameObject& other);
+
+    /// @brief Updates the area the object covers in its game scene's spatial grid, if the object has moved or changed size.
+    void UpdateIndex();
+
+    /// @brief Removes the object from its game scene's spatial grid.
+    void RemoveFromIndex();
+
     /// @brief Updates the debugging information for this object.
     void UpdateDebugInfo() const;
 
   protected:
     /// @brief The Z-layer this object occupies.
     int32_t layer_;
+    /// @brief The order the object was spawned in, used to order objects on the same layer. Unlike the object ID, this isn't reused when the object's slot is.
+    uint32_t creation_sequence_;
     /// @brief Is the mouse hovering over the object?
     bool is_hovering_;
+    /// @brief Has the object been culled from drawing this frame?
+    bool is_culled_;
+    /// @brief Is the object stored in its game scene's spatial grid?
+    bool is_indexed_;
+    /// @brief The top-left position of the area the object covers in the spatial grid.
+    glm::ivec2 indexed_position_;
+    /// @brief The size of the area the object covers in the spatial grid.
+    glm::ivec2 indexed_size_;
     /// @brief The top-left position of the object.
     glm::ivec2 position_;
     /// @brief The character data that will be copied to the buffer when rendered.
@@ -162,10 +356,93 @@ namespace term_engine::usertypes {
     AnimationState animation_state_;
     /// @brief The game scene this object renders to.
     GameScene* game_scene_;
+    /// @brief The position of the object in its game scene's list of objects.
+    size_t scene_index_;
+    /// @brief The tags the object has, including the names of its components.
+    TagMask tags_;
+    /// @brief The components attached to the object.
+    GameObjectComponentList components_;
+    /// @brief How the object collides with other objects.
+    CollisionMode collision_mode_;
+
+    /**
+     * @brief Sets or unsets a tag, adding or removing the object from the tag's set.
+     * 
+     * @param[in] tag_id The tag ID.
+     * @param[in] flag   Should the object have the tag?
+     */
+    void SetTag(size_t tag_id, bool flag);
+
+    /**
+     * @brief Adds the object to a game scene, giving it a new ID.
+     * 
+     * @param[in] game_scene The game scene the object belongs to.
+     */
+    void Attach(GameScene* game_scene);
   };
 
   /**
-   * @brief Adds a game object to the list.
+   * @brief A reference to a game object, which is how game objects are handed to Lua.
+   * @details Released objects are kept in the object pool and reused for new objects, so a raw pointer kept by a script could reach an unrelated object once it is reused.
+   *          The reference stores the object's ID instead, and looks it up each time it is used. Objects are given a new ID when reused, so the reference stops working once the object is released.
+   */
+  class GameObjectRef {
+  public:
+    /**
+     * @brief Constructs the reference to the given object.
+     * 
+     * @param[in] game_object The object to refer to.
+     */
+    GameObjectRef(GameObject* game_object);
+
+    /**
+     * @brief Returns the ID of the object that the reference was made to, even if it has since been released.
+     * 
+     * @returns The object ID.
+     */
+    uint64_t GetObjectId() const;
+
+    /**
+     * @brief Returns the object, if it hasn't been released.
+     * 
+     * @returns A raw pointer to the object, or a null pointer if it has been released.
+     */
+    GameObject* Get() const;
+
+    /**
+     * @brief Returns the object, raising a Lua error if it has been released.
+     * 
+     * @returns A reference to the object.
+     */
+    GameObject& GetChecked() const;
+
+    /**
+     * @brief Returns if both references were made to the same object.
+     * 
+     * @param[in] other The other reference.
+     * @returns If the references are to the same object.
+     */
+    bool operator==(const GameObjectRef& other) const;
+
+  protected:
+    /// @brief The ID of the object that the reference was made to.
+    uint64_t object_id_;
+  };
+
+  /// @brief Used to hand a list of game objects to Lua.
+  typedef std::vector<GameObjectRef> GameObjectRefList;
+
+  /// @brief The IDs of every game object. Objects add and remove themselves as they are added to and removed from game scenes.
+  inline GameObjectIdList game_object_ids(static_cast<uint8_t>(ObjectType::GAME_OBJECT));
+  /// @brief The creation sequence number to give to the next game object that is spawned.
+  inline uint32_t next_creation_sequence = 0;
+  /// @brief The game objects that have been released, and are waiting to be reused.
+  inline GameObjectList game_object_pool;
+  /// @brief The most game objects that the pool will keep for reuse.
+  inline size_t game_object_pool_size = DEFAULT_GAME_OBJECT_POOL_SIZE;
+
+  /**
+   * @brief Adds a game object to the given game scene.
    * 
    * @param[in] position   The position of the game object.
    * @param[in] size       The size of the game object, in rows & columns.
@@ -175,7 +452,7 @@ namespace term_engine::usertypes {
   GameObject* AddGameObjectToScene(const glm::ivec2& position, const glm::ivec2& size, GameSceneVariant game_scene);
 
   /**
-   * @brief Adds a game object for the default game scene to the list.
+   * @brief Adds a game object to the default game scene.
    * 
    * @param[in] position   The position of the game object.
    * @param[in] size       The size of the game object, in rows & columns.
@@ -184,11 +461,40 @@ namespace term_engine::usertypes {
   GameObject* AddGameObject(const glm::ivec2& position, const glm::ivec2& size);
 
   /**
-   * @brief Clears all game objects belonging to a game scene.
+   * @brief Adds copies of a game object to its game scene at each of the given positions.
+   * @details Released objects are reused where possible, and each copy shares the original object's character data until it is modified.
    * 
-   * @param[in] name The name of the game scene.
+   * @param[in] object    The game object to copy.
+   * @param[in] positions The list of positions to add copies at.
+   * @returns The list of copied game objects.
    */
-  void ClearGameObjectsByGameScene(const std::string& name);
+  std::vector<GameObject*> SpawnGameObjects(GameObject* object, const sol::table& positions);
+
+  /**
+   * @brief Returns a game object from the pool, or creates a new one if the pool is empty.
+   * @note The returned object isn't in a game scene until it is spawned.
+   * 
+   * @returns The game object.
+   */
+  GameObjectPtr AcquireGameObject();
+
+  /**
+   * @brief Puts a game object that has been taken from its game scene into the pool, or destroys it if the pool is full.
+   * 
+   * @param[in] game_object The game object to recycle.
+   */
+  void RecycleGameObject(GameObjectPtr&& game_object);
+
+  /**
+   * @brief Fills the pool with game objects ahead of time, so that they don't need to be created when spawned.
+   * @note This also raises the most game objects the pool will keep, if needed.
+   * 
+   * @param[in] count The number of game objects to keep in the pool.
+   */
+  void ReserveGameObjects(size_t count);
+
+  /// @brief Destroys the game objects in the pool, and resets the most it will keep.
+  void ClearGameObjectPool();
 
   /**
    * @brief Returns the game object with the given ID.
@@ -197,6 +503,22 @@ namespace term_engine::usertypes {
    * @returns A raw pointer to the game object, or a null pointer if not found.
    */
   GameObject* GetGameObjectById(uint64_t id);
+
+  /**
+   * @brief Makes a reference to the given game object, to hand to Lua.
+   * 
+   * @param[in] game_object The game object, or a null pointer.
+   * @returns The reference, or _nil_ if the game object is a null pointer.
+   */
+  sol::optional<GameObjectRef> MakeGameObjectRef(GameObject* game_object);
+
+  /**
+   * @brief Makes references to each of the given game objects, to hand to Lua.
+   * 
+   * @param[in] game_objects The list of game objects.
+   * @returns The list of references.
+   */
+  GameObjectRefList MakeGameObjectRefs(const std::vector<GameObject*>& game_objects);
 }
 
 #endif // ! GAME_OBJECT_H
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include "TagIndex.h"
+#include "GameObject.h"
+#include "../../utility/LogUtils.h"
+
+namespace term_engine::usertypes {
+  void TagSet::Insert(GameObject* object)
+  {
+    const uint32_t slot_index = utility::GetSlotHandleIndex(object->GetObjectId());
+
+    if (slot_index >= positions_.size())
+    {
+      positions_.resize(slot_index + 1, NULL_TAG_POSITION);
+    }
+
+    if (positions_[slot_index] == NULL_TAG_POSITION)
+    {
+      positions_[slot_index] = (uint32_t)objects_.size();
+      objects_.push_back(object);
+    }
+  }
+
+  void TagSet::Remove(GameObject* object)
+  {
+    const uint32_t slot_index = utility::GetSlotHandleIndex(object->GetObjectId());
+
+    if (slot_index >= positions_.size() || positions_[slot_index] == NULL_TAG_POSITION)
+    {
+      return;
+    }
+
+    const uint32_t position = positions_[slot_index];
+
+    if (position != objects_.size() - 1)
+    {
+      objects_[position] = objects_.back();
+      positions_[utility::GetSlotHandleIndex(objects_[position]->GetObjectId())] = position;
+    }
+
+    objects_.pop_back();
+    positions_[slot_index] = NULL_TAG_POSITION;
+  }
+
+  const TaggedObjectList& TagSet::GetObjects() const
+  {
+    return objects_;
+  }
+
+  void TagSet::Clear()
+  {
+    objects_.clear();
+    positions_.clear();
+  }
+
+  size_t TagIndex::GetOrAddTagId(const std::string& name)
+  {
+    const size_t tag_id = GetTagId(name);
+
+    if (tag_id != NULL_TAG_ID)
+    {
+      return tag_id;
+    }
+
+    if (tag_names_.size() >= MAX_TAG_COUNT)
+    {
+      utility::LogWarn("Cannot add tag or component \"{}\", as all {} tag IDs are in use! Tags and component names share these IDs, which are only freed when the project is reloaded.", name, MAX_TAG_COUNT);
+
+      return NULL_TAG_ID;
+    }
+
+    tag_ids_.emplace(name, tag_names_.size());
+    tag_names_.push_back(name);
+
+    return tag_names_.size() - 1;
+  }
+
+  size_t TagIndex::GetTagId(const std::string& name) const
+  {
+    std::unordered_map<std::string, size_t>::const_iterator it = tag_ids_.find(name);
+
+    return it != tag_ids_.end() ? it->second : NULL_TAG_ID;
+  }
+
+  std::string TagIndex::GetTagName(size_t tag_id) const
+  {
+    return tag_id < tag_names_.size() ? tag_names_[tag_id] : "";
+  }
+
+  TagSet& TagIndex::GetTagSet(size_t tag_id)
+  {
+    return tag_sets_[tag_id];
+  }
+
+  size_t TagIndex::GetTagCount() const
+  {
+    return tag_names_.size();
+  }
+
+  void TagIndex::Clear()
+  {
+    for (TagSet& tag_set : tag_sets_)
+    {
+      tag_set.Clear();
+    }
+
+    tag_ids_.clear();
+    tag_names_.clear();
+  }
+
+  GameObjectQuery::GameObjectQuery(const TagMask& mask, size_t tag_id) :
+    mask_(mask),
+    tag_id_(tag_id),
+    remaining_(tag_id != NULL_TAG_ID ? tag_index.GetTagSet(tag_id).GetObjects().size() : 0)
+  {}
+
+  GameObject* GameObjectQuery::Next()
+  {
+    if (tag_id_ == NULL_TAG_ID)
+    {
+      return nullptr;
+    }
+
+    const TaggedObjectList& objects = tag_index.GetTagSet(tag_id_).GetObjects();
+
+    // The set is iterated from the end, so that removing the current object only moves an object that has already been checked into its place.
+    remaining_ = std::min(remaining_, objects.size());
+
+    while (remaining_ > 0)
+    {
+      GameObject* object = objects[--remaining_];
+
+      if ((object->GetTags() & mask_) == mask_)
+      {
+        return object;
+      }
+    }
+
+    return nullptr;
+  }
+
+  GameObjectQuery QueryGameObjects(const sol::variadic_args& tags)
+  {
+    TagMask mask;
+    size_t smallest_tag_id = NULL_TAG_ID;
+
+    for (auto tag : tags)
+    {
+      const size_t tag_id = tag_index.GetTagId(tag.as<std::string>());
+
+      // No object can have a tag that hasn't been given an ID.
+      if (tag_id == NULL_TAG_ID)
+      {
+        return GameObjectQuery(mask, NULL_TAG_ID);
+      }
+
+      mask.set(tag_id);
+
+      if (smallest_tag_id == NULL_TAG_ID || tag_index.GetTagSet(tag_id).GetObjects().size() < tag_index.GetTagSet(smallest_tag_id).GetObjects().size())
+      {
+        smallest_tag_id = tag_id;
+      }
+    }
+
+    if (smallest_tag_id == NULL_TAG_ID)
+    {
+      utility::LogWarn("Cannot query game objects without any tags!");
+    }
+
+    return GameObjectQuery(mask, smallest_tag_id);
+  }
+}
@@ -0,0 +1,169 @@
+/// @author James Holtom
+
+#ifndef TAG_INDEX_H
+#define TAG_INDEX_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../utility/SolUtils.h"
+
+namespace term_engine::usertypes {
+  class GameObject;
+
+  /// @brief The most tags that can be in use at once, including component names.
+  constexpr size_t MAX_TAG_COUNT = 64;
+  /// @brief Refers to a tag that doesn't exist.
+  constexpr size_t NULL_TAG_ID = MAX_TAG_COUNT;
+  /// @brief Marks an object that isn't in a tag set.
+  constexpr uint32_t NULL_TAG_POSITION = UINT32_MAX;
+
+  /// @brief Used to store which tags an object has, with a bit for each tag ID.
+  typedef std::bitset<MAX_TAG_COUNT> TagMask;
+  /// @brief Used to store the objects that have a tag.
+  typedef std::vector<GameObject*> TaggedObjectList;
+
+  /**
+   * @brief Stores the objects that have a particular tag, as a sparse set.
+   * @details The objects are packed together for iteration, and each object's position in the list is looked up by its slot index. This gives constant-time insertion and removal.
+   */
+  class TagSet {
+  public:
+    /**
+     * @brief Adds an object to the set.
+     * @note The object must have an ID.
+     * 
+     * @param[in] object A raw pointer to the object.
+     */
+    void Insert(GameObject* object);
+
+    /**
+     * @brief Removes an object from the set, moving the last object into its place.
+     * 
+     * @param[in] object A raw pointer to the object.
+     */
+    void Remove(GameObject* object);
+
+    /**
+     * @brief Returns the objects in the set.
+     * 
+     * @returns The list of objects, in no particular order.
+     */
+    const TaggedObjectList& GetObjects() const;
+
+    /// @brief Removes all objects from the set.
+    void Clear();
+
+  protected:
+    /// @brief The objects in the set, packed together.
+    TaggedObjectList objects_;
+    /// @brief The position of each object in the list, indexed by the object's slot index.
+    std::vector<uint32_t> positions_;
+  };
+
+  /// @brief Gives each tag name an ID, and keeps the set of objects that have each tag.
+  class TagIndex {
+  public:
+    /**
+     * @brief Returns the ID of the given tag, giving it one if it doesn't have one yet.
+     * @note Component names are given IDs from the same pool, and IDs aren't freed until the index is cleared.
+     * 
+     * @param[in] name The name of the tag.
+     * @returns The tag ID, or _NULL_TAG_ID_ if there are no more tag IDs available.
+     */
+    size_t GetOrAddTagId(const std::string& name);
+
+    /**
+     * @brief Returns the ID of the given tag.
+     * 
+     * @param[in] name The name of the tag.
+     * @returns The tag ID, or _NULL_TAG_ID_ if no object has been given the tag.
+     */
+    size_t GetTagId(const std::string& name) const;
+
+    /**
+     * @brief Returns the name of the tag with the given ID.
+     * 
+     * @param[in] tag_id The tag ID.
+     * @returns The tag name.
+     */
+    std::string GetTagName(size_t tag_id) const;
+
+    /**
+     * @brief Returns the set of objects that have the given tag.
+     * 
+     * @param[in] tag_id The tag ID.
+     * @returns The tag set.
+     */
+    TagSet& GetTagSet(size_t tag_id);
+
+    /**
+     * @brief Returns the number of tags that have been given an ID.
+     * 
+     * @returns The number of tags.
+     */
+    size_t GetTagCount() const;
+
+    /// @brief Removes all tags and their sets.
+    void Clear();
+
+  protected:
+    /// @brief The ID of each tag, indexed by name.
+    std::unordered_map<std::string, size_t> tag_ids_;
+    /// @brief The name of each tag, indexed by ID.
+    std::vector<std::string> tag_names_;
+    /// @brief The set of objects with each tag, indexed by ID.
+    std::array<TagSet, MAX_TAG_COUNT> tag_sets_;
+  };
+
+  /**
+   * @brief Iterates over the game objects that have all of the given tags, without building a list of them.
+   * @details The objects are taken from the smallest set of the given tags, so only objects that have at least one of the tags are checked.
+   *          Objects can be tagged, untagged and released while iterating, as the objects are read from the set on each step.
+   */
+  class GameObjectQuery {
+  public:
+    /**
+     * @brief Constructs the query.
+     * 
+     * @param[in] mask   The tags that each object must have.
+     * @param[in] tag_id The tag whose set is iterated over, or _NULL_TAG_ID_ if no objects can match.
+     */
+    GameObjectQuery(const TagMask& mask, size_t tag_id);
+
+    /**
+     * @brief Returns the next object that has all of the tags.
+     * 
+     * @returns A raw pointer to the object, or a null pointer if there are none left.
+     */
+    GameObject* Next();
+
+  protected:
+    /// @brief The tags that each object must have.
+    TagMask mask_;
+    /// @brief The tag whose set is iterated over.
+    size_t tag_id_;
+    /// @brief The number of objects in the set that haven't been checked yet.
+    size_t remaining_;
+  };
+
+  /**
+   * @brief The tags of every game object, shared by all game scenes.
+   * @details Component names are given IDs from the same _MAX_TAG_COUNT_ cap as tags, and IDs are only freed when the project is reloaded.
+   */
+  inline TagIndex tag_index;
+
+  /**
+   * @brief Returns a query over the game objects that have all of the given tags.
+   * @note The query covers the game objects in every game scene, as the tag index is global.
+   * 
+   * @param[in] tags The names of the tags.
+   * @returns The query, which can be used as an iterator in a for loop.
+   */
+  GameObjectQuery QueryGameObjects(const sol::variadic_args& tags);
+}
+
+#endif // ! TAG_INDEX_H
@@ -1,74 +1,82 @@
+#include <cinttypes>
 #include "TimedFunction.h"
 #include "../../scripting/ScriptingInterface.h"
+#include "../../system/Tracer.h"
 #include "../../utility/ImGuiUtils.h"
 #include "../../utility/LogUtils.h"
 
 namespace term_engine::usertypes {
   TimedFunction::TimedFunction(uint64_t delay, bool started, bool repeat, const sol::function callback) :
-    BaseObject(),
-    accumulator_(0),
+    BaseObject(ObjectType::TIMED_FUNCTION, timed_function_list.GetNextHandle()),
+    paused_elapsed_(0),
+    start_time_(timed_function_wheel.GetTime()),
+    timer_id_(system::NULL_TIMER_ID),
     delay_(delay),
     repeat_(repeat),
     times_fired_(0),
     callback_(sol::make_reference<sol::function>((*scripting::lua_state), callback))
   {
     is_active_ = started;
+
+    if (started)
+    {
+      Schedule(0);
+    }
     
     utility::LogDebug("Created {} timed function with ID {} and delay of {}ms.", repeat ? "repeatable" : "non-repeatable", object_id_, delay_);
   }
 
   TimedFunction::~TimedFunction()
   {
+    Unschedule();
     callback_ = sol::nil;
 
     utility::LogDebug("Removed timed function with ID {}.", object_id_);
   }
 
-  void TimedFunction::Update(uint64_t timestep)
+  void TimedFunction::Trigger()
   {
-    if (is_active_ && callback_.valid())
-    {
-      accumulator_ += timestep;
+    const uint64_t elapsed = timed_function_wheel.GetTime() - start_time_;
 
-      if (accumulator_ >= delay_)
-      {
-        times_fired_++;
+    // The wheel frees timers as they expire, so the function no longer has one.
+    timer_id_ = system::NULL_TIMER_ID;
 
-        try
-        {
-          sol::protected_function_result result = callback_(this, accumulator_);
+    if (callback_.valid())
+    {
+      system::TraceScope scope("TimedFunction::Trigger");
 
-          if (!result.valid())
-          {
-            sol::error err = result;
-            utility::LogError("An error was thrown!\nProject: {}\n Error: {}", scripting::project_path.string(), err.what());
-          }
-        }
-        catch (const std::exception& err)
-        {
-          utility::LogError("A scripting error occurred!\nProject: {}\nError: {}", scripting::project_path.string(), err.what());
-        }
+      times_fired_++;
 
-        if (repeat_)
-        {
-          accumulator_ = 0;
-        }
-        else
+      try
+      {
+        sol::protected_function_result result = callback_(this, elapsed);
+
+        if (!result.valid())
         {
-          Stop();
+          sol::error err = result;
+          utility::LogError("An error was thrown!\nProject: {}\n Error: {}", scripting::project_path.string(), err.what());
         }
       }
+      catch (const std::exception& err)
+      {
+        utility::LogError("A scripting error occurred!\nProject: {}\nError: {}", scripting::project_path.string(), err.what());
+      }
     }
-  }
 
-  std::string TimedFunction::GetObjectType() const
-  {
-    return std::string(TIMED_FUNCTION_TYPE);
-  }
+    // The callback may have stopped, paused or restarted the function, in which case its timer has already been dealt with.
+    if (!is_active_ || timer_id_ != system::NULL_TIMER_ID)
+    {
+      return;
+    }
 
-  ObjectSortPriority TimedFunction::GetListPriority() const
-  {
-    return ObjectSortPriority::TIMED_FUNCTION;
+    if (repeat_)
+    {
+      Schedule(0);
+    }
+    else
+    {
+      Stop();
+    }
   }
 
   uint64_t TimedFunction::GetDelay() const
@@ -86,16 +94,47 @@ namespace term_engine::usertypes {
     return times_fired_;
   }
 
+  uint64_t TimedFunction::GetElapsed() const
+  {
+    return is_active_ ? timed_function_wheel.GetTime() - start_time_ : paused_elapsed_;
+  }
+
+  system::TimerId TimedFunction::GetTimerId() const
+  {
+    return timer_id_;
+  }
+
+  void TimedFunction::SetActive(bool flag)
+  {
+    if (flag == is_active_)
+    {
+      return;
+    }
+
+    if (flag)
+    {
+      is_active_ = true;
+      Schedule(paused_elapsed_);
+    }
+    else
+    {
+      paused_elapsed_ = GetElapsed();
+      is_active_ = false;
+      Unschedule();
+    }
+  }
+
   void TimedFunction::Start()
   {
-    accumulator_ = 0;
     times_fired_ = 0;
     is_active_ = true;
+    Schedule(0);
   }
 
   void TimedFunction::Stop()
   {
-    accumulator_ = 0;
+    Unschedule();
+    paused_elapsed_ = 0;
     is_active_ = false;
   }
 
@@ -104,22 +143,45 @@ namespace term_engine::usertypes {
     repeat_ = flag;
   }
 
+  void TimedFunction::Remove()
+  {
+    timed_function_list.Remove(object_id_);
+  }
+
+  void TimedFunction::Schedule(uint64_t elapsed)
+  {
+    Unschedule();
+
+    start_time_ = timed_function_wheel.GetTime() - elapsed;
+    timer_id_ = timed_function_wheel.Schedule(delay_ > elapsed ? delay_ - elapsed : 0, object_id_);
+  }
+
+  void TimedFunction::Unschedule()
+  {
+    if (timer_id_ != system::NULL_TIMER_ID)
+    {
+      timed_function_wheel.Cancel(timer_id_);
+      timer_id_ = system::NULL_TIMER_ID;
+    }
+  }
+
   void TimedFunction::UpdateDebugInfo() const
   {
-    if (ImGui::TreeNode((void*)this, "%s #%li", GetObjectType().c_str(), object_id_))
+    if (ImGui::TreeNode((void*)this, "%s #%" PRIu64, GetObjectTypeName().c_str(), object_id_))
     {
-      ImGui::Text("ID: %lu", object_id_);
+      ImGui::Text("ID: %" PRIu64, object_id_);
       ImGui::Text("Active?: %s", is_active_ ? "Yes" : "No");
       ImGui::Text("Repeat?: %s", repeat_ ? "Yes" : "No");
-      ImGui::Text("Delay: %lu", delay_);
+      ImGui::Text("Delay: %" PRIu64, delay_);
       ImGui::Text("Times Fired: %u", times_fired_);
       
       ImGui::Text("Progress:");
       ImGui::SameLine();
 
+      const uint64_t elapsed = GetElapsed();
       char buf[32];
-      sprintf(buf, "%li/%li", accumulator_, delay_);
-      ImGui::ProgressBar((float)accumulator_ / (float)delay_, ImVec2(0.0f, 0.0f), buf);
+      sprintf(buf, "%" PRIu64 "/%" PRIu64, elapsed, delay_);
+      ImGui::ProgressBar((float)elapsed / (float)delay_, ImVec2(0.0f, 0.0f), buf);
 
       ImGui::TreePop();
     }
@@ -136,32 +198,65 @@ namespace term_engine::usertypes {
       set_delay = 0;
     }
 
-    is_object_list_dirty = true;
+    const uint64_t id = timed_function_list.Insert(std::make_unique<TimedFunction>(set_delay, started, repeat, callback));
 
-    object_list.emplace_front(std::make_shared<TimedFunction>(set_delay, started, repeat, callback));
-
-    return static_cast<TimedFunction*>(object_list.front().get());
+    return timed_function_list.Get(id)->get();
   }
 
   TimedFunction* GetTimedFunctionById(uint64_t id)
   {
-    for (auto& object : object_list)
+    TimedFunctionPtr* timed_function = timed_function_list.Get(id);
+
+    if (timed_function == nullptr)
     {
-      if (object->GetObjectId() == id)
+      if (utility::GetSlotHandleTag(id) != timed_function_list.GetTag())
       {
-        if (object->GetObjectType() == std::string(TIMED_FUNCTION_TYPE))
-        {
-          return static_cast<TimedFunction*>(object.get());
-        }
+        utility::LogWarn("Object with ID {} is not a timed function.", id);
       }
-      else
-      {
-        utility::LogWarn("Object with ID {} is the name of a(n) {}.", id, object->GetObjectType());
 
-        return nullptr;
+      return nullptr;
+    }
+
+    return timed_function->get();
+  }
+
+  void UpdateTimedFunctions(uint64_t timestep)
+  {
+    static system::TimerExpiryList expired;
+
+    // The wheel ticks in whole milliseconds, so the time left over is carried into the next update rather than lost.
+    timed_function_remainder += timestep;
+
+    const uint64_t ticks = timed_function_remainder / NANOSECONDS_PER_MILLISECOND;
+    timed_function_remainder -= ticks * NANOSECONDS_PER_MILLISECOND;
+
+    expired.clear();
+    timed_function_wheel.Advance(ticks, expired);
+
+    for (const system::TimerExpiry& expiry : expired)
+    {
+      TimedFunctionPtr* timed_function = timed_function_list.Get(expiry.payload_);
+
+      // Functions stopped or restarted by an earlier callback no longer have the expired timer, so are skipped.
+      if (timed_function != nullptr && (*timed_function)->GetTimerId() == expiry.id_)
+      {
+        (*timed_function)->Trigger();
       }
     }
+  }
+
+  uint64_t GetTimeUntilNextTimedFunction()
+  {
+    const uint64_t ticks = timed_function_wheel.GetTimeUntilNextExpiry();
+
+    if (ticks == UINT64_MAX)
+    {
+      return UINT64_MAX;
+    }
+
+    // Part of the next tick may have already passed, and is waiting in the remainder.
+    const uint64_t time_until_expiry = ticks * NANOSECONDS_PER_MILLISECOND;
 
-    return nullptr;
+    return time_until_expiry > timed_function_remainder ? time_until_expiry - timed_function_remainder : 0;
   }
-}
\ No newline at end of file
+}
@@ -3,17 +3,27 @@
 #ifndef TIMED_FUNCTION_H
 #define TIMED_FUNCTION_H
 
+#include <memory>
 #include <string>
 #include "BaseObject.h"
 #include "../Timer.h"
+#include "../../system/TimerWheel.h"
+#include "../../utility/SlotMap.h"
 #include "../../utility/SolUtils.h"
 
 namespace term_engine::usertypes {
+  class TimedFunction;
+
+  /// @brief Unique pointer to a timed function.
+  typedef std::unique_ptr<TimedFunction> TimedFunctionPtr;
+  /// @brief Used to store a list of timed functions, which are looked up by their ID.
+  typedef utility::SlotMap<TimedFunctionPtr> TimedFunctionList;
+
   /// @brief The type name for TimedFunctions.
   constexpr char TIMED_FUNCTION_TYPE[] = "TimedFunction";
 
   /// @brief Used to delay the execution of a function by a set amount of time.
-  class TimedFunction : public BaseObject {
+  class TimedFunction final : public BaseObject {
   public:
     /**
      * @brief Constructs the timed function with the given parameters.
@@ -29,26 +39,10 @@ namespace term_engine::usertypes {
     ~TimedFunction();
 
     /**
-     * @brief Updates the timed function.
-     * 
-     * @param[in] timestep The time since the last update, in milliseconds (ms).
-     */
-    void Update(uint64_t timestep);
-
-    /**
-     * @brief Returns the type of the object.
-     * 
-     * @returns The object type.
+     * @brief Calls the function, and then schedules it again if it repeats or stops it if it doesn't.
+     * @note This is called when the function's timer expires.
      */
-    std::string GetObjectType() const;
-
-    /**
-     * @brief Returns the list priority for this object.
-     * @details This is used to sort the list of objects before updating.
-     * 
-     * @returns The priority for this object.
-     */
-    ObjectSortPriority GetListPriority() const;
+    void Trigger();
 
     /**
      * @brief Returns the amount of delay before calling the function, in milliseconds (ms).
@@ -71,6 +65,27 @@ namespace term_engine::usertypes {
      */
     uint32_t GetTimesCalled() const;
 
+    /**
+     * @brief Returns the amount of time since the timer was started, or since the function was last called if it repeats.
+     * 
+     * @returns The elapsed time, in milliseconds (ms).
+     */
+    uint64_t GetElapsed() const;
+
+    /**
+     * @brief Returns the ID of the function's timer in the timer wheel.
+     * 
+     * @returns The timer ID, or _NULL_TIMER_ID_ if the timer isn't running.
+     */
+    system::TimerId GetTimerId() const;
+
+    /**
+     * @brief Sets if the timer is running. Unlike stopping the timer, pausing it keeps the time elapsed so far.
+     * 
+     * @param[in] flag If the timer is running.
+     */
+    void SetActive(bool flag);
+
     /// @brief Starts the timer for the function, allowing it to trigger.
     void Start();
 
@@ -84,12 +99,19 @@ namespace term_engine::usertypes {
      */
     void SetRepeatable(bool flag);
 
+    /// @brief Removes the timed function from the list.
+    void Remove();
+
     /// @brief Updates the debugging information for this object.
     void UpdateDebugInfo() const;
 
   protected:
-    /// @brief The amount of time since starting the timer.
-    uint64_t accumulator_;
+    /// @brief The time elapsed before the timer was paused.
+    uint64_t paused_elapsed_;
+    /// @brief The time of the timer wheel when the timer was started, or when the function was last called if it repeats.
+    uint64_t start_time_;
+    /// @brief The ID of the function's timer in the timer wheel.
+    system::TimerId timer_id_;
     /// @brief The length of the delay before triggering the callback.
     uint64_t delay_;
     /// @brief Whether the callback is triggered repeatedly or not.
@@ -98,8 +120,25 @@ namespace term_engine::usertypes {
     uint32_t times_fired_;
     /// @brief The callback function to call when the delay has finished.
     sol::function callback_;
+
+    /**
+     * @brief Schedules the function's timer, so that it expires once the rest of the delay has passed.
+     * 
+     * @param[in] elapsed The time that has already elapsed, in milliseconds (ms).
+     */
+    void Schedule(uint64_t elapsed);
+
+    /// @brief Cancels the function's timer, if it is running.
+    void Unschedule();
   };
 
+  /// @brief Schedules the timed functions, so that only the functions that are due are touched each frame.
+  inline system::TimerWheel timed_function_wheel;
+  /// @brief The time that has passed since the timer wheel was last advanced by a whole millisecond, in nanoseconds (ns).
+  inline uint64_t timed_function_remainder = 0;
+  /// @brief The list of timed functions.
+  inline TimedFunctionList timed_function_list(static_cast<uint8_t>(ObjectType::TIMED_FUNCTION));
+
   /**
    * @brief Adds a timed function to the list.
    * 
@@ -112,12 +151,26 @@ namespace term_engine::usertypes {
   TimedFunction* AddTimedFunction(uint64_t delay, bool started, bool repeat, const sol::function callback);
 
   /**
-   * @brief Returns the game object with the given ID.
+   * @brief Returns the timed function with the given ID.
    * 
-   * @param[in] id The ID of the game object.
-   * @returns A raw pointer to the game object, or a null pointer if not found.
+   * @param[in] id The ID of the timed function.
+   * @returns A raw pointer to the timed function, or a null pointer if not found.
    */
   TimedFunction* GetTimedFunctionById(uint64_t id);
+
+  /**
+   * @brief Advances the timer wheel, and calls each timed function whose timer has expired.
+   * 
+   * @param[in] timestep The time since the last update, in nanoseconds (ns).
+   */
+  void UpdateTimedFunctions(uint64_t timestep);
+
+  /**
+   * @brief Returns how long until the next timed function could be called.
+   * 
+   * @returns The amount of time, in nanoseconds (ns), or _UINT64_MAX_ if no timed functions are running.
+   */
+  uint64_t GetTimeUntilNextTimedFunction();
 }
 
 #endif // ! TIMED_FUNCTION_H
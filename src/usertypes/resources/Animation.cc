@@ -1,5 +1,6 @@
 #include <optional>
 #include "Animation.h"
+#include "../Timer.h"
 #include "../../utility/ConversionUtils.h"
 #include "../../utility/ImGuiUtils.h"
 
@@ -185,7 +186,7 @@ namespace term_engine::usertypes {
     current_animation_frame_(0),
     frame_duration_(0) {};
   
-  void AnimationState::Update(uint32_t timestep)
+  void AnimationState::Update(uint64_t timestep)
   {
     if (animations_.empty() || !is_playing_)
     {
@@ -208,7 +209,7 @@ namespace term_engine::usertypes {
 
     assert(current_frame != nullptr);
 
-    uint32_t accumulator_limit = frame_duration_ + current_frame->GetAddedDuration();
+    const uint64_t accumulator_limit = (uint64_t)(frame_duration_ + current_frame->GetAddedDuration()) * NANOSECONDS_PER_MILLISECOND;
     int32_t frame_offset = is_reversing_ ? -1 : 1;
     uint32_t last_frame = animations_.front().animation_->GetFrameCount() - 1;
 
@@ -253,9 +253,9 @@ namespace term_engine::usertypes {
     /**
      * @brief Updates the animation state.
      * 
-     * @param[in] timestep The time since the last update, in milliseconds (ms).
+     * @param[in] timestep The time since the last update, in nanoseconds (ns).
      */
-    void Update(uint32_t timestep);
+    void Update(uint64_t timestep);
 
     /**
      * @brief Returns the list of queued animations.
@@ -410,8 +410,8 @@ namespace term_engine::usertypes {
     bool is_reversing_;
     /// @brief Has the animation reached the end of play?
     bool end_of_animation_;
-    /// @brief The amount of time the current frame has been rendered for.
-    uint32_t animation_accumulator_;
+    /// @brief The amount of time the current frame has been rendered for, in nanoseconds (ns).
+    uint64_t animation_accumulator_;
     /// @brief The index of the current frame of animation.
     uint32_t current_animation_frame_;
     /// @brief How long each frame plays for, in milliseconds (ms).
@@ -1,6 +1,7 @@
 #include "BaseResource.h"
 #include "Font.h"
 #include "ShaderProgram.h"
+#include "../../rendering/RenderThread.h"
 #include "../../utility/ImGuiUtils.h"
 
 namespace term_engine::usertypes {
@@ -14,6 +15,17 @@ namespace term_engine::usertypes {
     return name_;
   }
 
+  void BaseResource::Remove()
+  {
+    // The name is copied, as erasing the resource destroys the name it is keyed by.
+    const std::string name = name_;
+
+    // The resource's textures/shaders may still be in use by the frame being drawn.
+    rendering::WaitForRenderThread();
+
+    resource_list.erase(name);
+  }
+
   void RemoveResource(BaseResourceVariant resource)
   {
     BaseResource* ptr = nullptr;
@@ -50,15 +62,4 @@ namespace term_engine::usertypes {
 
     utility::LogDebug("Cleared all resources from the list.");
   }
-
-  void ClearFlaggedResources()
-  {
-    for (auto& [ name, resource ] : resource_list)
-    {
-      if (resource->FlaggedForRemoval())
-      {
-        resource_list.erase(name);
-      }
-    }
-  }
-}
\ No newline at end of file
+}
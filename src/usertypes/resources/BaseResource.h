@@ -47,6 +47,9 @@ namespace term_engine::usertypes {
      */
     std::string GetName() const;
 
+    /// @brief Removes the resource from the list, destroying it.
+    void Remove();
+
     /// @brief Updates the debugging information for this resource.
     virtual void UpdateDebugInfo() const = 0;
 
@@ -64,9 +67,6 @@ namespace term_engine::usertypes {
 
   /// @brief Removes all resources in the list.
   void CleanUpResources();
-
-  /// @brief Clears all resources that are flagged for removal from the list.
-  void ClearFlaggedResources();
 }
 
 #endif // ! BASE_RESOURCE_H
\ No newline at end of file
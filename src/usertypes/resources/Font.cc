@@ -95,6 +95,11 @@ namespace term_engine::usertypes {
     }
   }
 
+  bool Font::IsTextureDirty() const
+  {
+    return texture_dirty_;
+  }
+
   void Font::UpdateTexture()
   {
     assert(texture_);
@@ -115,6 +120,13 @@ namespace term_engine::usertypes {
     glBindTexture(GL_TEXTURE_2D, texture_->texture_id_);
   }
 
+  const rendering::TextureData& Font::GetTextureData() const
+  {
+    assert(texture_);
+
+    return *texture_;
+  }
+
   CharacterBB Font::CreateCharTexture(uint64_t character, uint32_t size)
   {
     if (size == 0) {
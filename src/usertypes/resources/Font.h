@@ -146,12 +146,26 @@ namespace term_engine::usertypes {
      */
     CharacterBB GetCharacter(char16_t character, uint32_t size);
 
+    /**
+     * @brief Returns if characters have been added to the font since the texture was last updated.
+     * 
+     * @returns If the font texture needs updating.
+     */
+    bool IsTextureDirty() const;
+
     /// @brief Updates the font texture with newly added characters.
     void UpdateTexture();
 
     /// @brief Binds the font atlas's texture ID to it's index.
     void Use();
 
+    /**
+     * @brief Returns the texture data of the font atlas.
+     * 
+     * @returns The texture data.
+     */
+    const rendering::TextureData& GetTextureData() const;
+
     /// @brief Updates the debugging information for this resource.
     void UpdateDebugInfo() const;
   };
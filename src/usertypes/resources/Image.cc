@@ -29,6 +29,11 @@ namespace term_engine::usertypes {
     return texture_->size_;
   }
 
+  const rendering::TextureData& Image::GetTextureData() const
+  {
+    return *texture_;
+  }
+
   void Image::Use() const
   {
     glActiveTexture(GL_TEXTURE0 + texture_->texture_unit_);
@@ -36,6 +36,13 @@ namespace term_engine::usertypes {
      */
     glm::ivec2 GetTextureSize() const;
 
+    /**
+     * @brief Returns the texture data of the image.
+     * 
+     * @returns The texture data.
+     */
+    const rendering::TextureData& GetTextureData() const;
+
     /// @brief Binds the image's texture ID to it's index.
     void Use() const;
 
@@ -1,10 +1,15 @@
+#include <cinttypes>
 #include "../events/InputManager.h"
 #include "../system/CLArguments.h"
 #include "../system/FileFunctions.h"
 #include "../system/FPSManager.h"
+#include "../system/Profiler.h"
+#include "../usertypes/CharacterMap.h"
 #include "../usertypes/EventListener.h"
 #include "../usertypes/GameScene.h"
 #include "../usertypes/game_objects/BaseObject.h"
+#include "../usertypes/game_objects/GameObject.h"
+#include "../usertypes/game_objects/TimedFunction.h"
 #include "../usertypes/resources/BaseResource.h"
 #include "../usertypes/resources/Font.h"
 #include "ImGuiUtils.h"
@@ -96,7 +101,10 @@ namespace term_engine::utility {
 
     ImGui::Text("FPS (Average): %.3f", system::GetAverageFPS());
     ImGui::Text("FPS (Target): %i", system::GetTargetFPS());
+    ImGui::Text("Tick Rate: %i", system::GetTickRate());
+    ImGui::Text("Frame Time (p50/p99): %.3fms/%.3fms", system::GetFrameTimeP50(), system::GetFrameTimeP99());
     ImGui::Text("Project: %s", system::scriptPath.c_str());
+    ImGui::Text("Shared Character Data: %" PRIu64 " bytes saved", usertypes::CharacterMap::GetSharedBytes());
 
     ImGui::BeginTabBar("Lists");
   }
@@ -201,13 +209,31 @@ namespace term_engine::utility {
 
     if (ImGui::BeginTabItem("Game Objects"))
     {
-      ImGui::Text("Next ID: %lu", usertypes::BaseObject::GetNextId());
+      ImGui::Text("Game Objects: %zu", usertypes::game_object_ids.Size());
+      ImGui::Text("Pooled Game Objects: %zu", usertypes::game_object_pool.size());
+      ImGui::Text("Tags: %zu", usertypes::tag_index.GetTagCount());
+      ImGui::Text("Timed Functions: %zu", usertypes::timed_function_list.Size());
+      ImGui::Text("Scheduled Timers: %zu", usertypes::timed_function_wheel.GetTimerCount());
+      ImGui::Text("Drawn: %" PRIu64, usertypes::objects_drawn);
+      ImGui::Text("Culled: %" PRIu64, usertypes::objects_culled);
 
-      for (usertypes::ObjectPtr& object : usertypes::object_list)
+      for (usertypes::TimedFunctionPtr& timed_function : usertypes::timed_function_list)
       {
-          object->UpdateDebugInfo();
+          timed_function->UpdateDebugInfo();
       }
 
+      for (usertypes::GameObject* game_object : usertypes::game_object_ids)
+      {
+          game_object->UpdateDebugInfo();
+      }
+
+      ImGui::EndTabItem();
+    }
+
+    if (ImGui::BeginTabItem("Profiler"))
+    {
+      system::UpdateProfilerDebugInfo();
+
       ImGui::EndTabItem();
     }
 
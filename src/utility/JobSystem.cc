@@ -0,0 +1,147 @@
+#include <algorithm>
+#include "JobSystem.h"
+#include "LogUtils.h"
+
+namespace term_engine::utility {
+  JobSystem::JobSystem(size_t worker_count) :
+    job_(nullptr),
+    count_(0),
+    batch_size_(1),
+    next_item_(0),
+    busy_workers_(0),
+    job_generation_(0),
+    is_stopping_(false)
+  {
+    for (size_t index = 0; index < worker_count; ++index)
+    {
+      workers_.emplace_back(&JobSystem::Run, this);
+    }
+
+    LogDebug("Started job system with {} worker(s).", worker_count);
+  }
+
+  JobSystem::~JobSystem()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopping_ = true;
+    }
+
+    job_cv_.notify_all();
+
+    for (std::thread& worker : workers_)
+    {
+      worker.join();
+    }
+
+    LogDebug("Stopped job system.");
+  }
+
+  size_t JobSystem::GetWorkerCount() const
+  {
+    return workers_.size();
+  }
+
+  void JobSystem::ParallelFor(size_t count, size_t batch_size, const JobFunction& job)
+  {
+    batch_size = std::max(batch_size, (size_t)1);
+
+    // Waking the workers costs more than running a single batch, so run it here instead.
+    if (count <= batch_size || workers_.empty())
+    {
+      if (count > 0)
+      {
+        job(0, count);
+      }
+
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &job;
+      count_ = count;
+      batch_size_ = batch_size;
+      next_item_ = 0;
+      busy_workers_ = workers_.size();
+      ++job_generation_;
+    }
+
+    job_cv_.notify_all();
+
+    // The calling thread takes batches as well, rather than waiting idle.
+    RunBatches();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return busy_workers_ == 0; });
+    job_ = nullptr;
+  }
+
+  void JobSystem::RunBatches()
+  {
+    while (true)
+    {
+      const size_t begin = next_item_.fetch_add(batch_size_);
+
+      if (begin >= count_)
+      {
+        break;
+      }
+
+      (*job_)(begin, std::min(begin + batch_size_, count_));
+    }
+  }
+
+  void JobSystem::Run()
+  {
+    uint64_t last_generation = 0;
+
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_cv_.wait(lock, [this, &last_generation]() { return is_stopping_ || job_generation_ != last_generation; });
+
+        if (is_stopping_)
+        {
+          return;
+        }
+
+        last_generation = job_generation_;
+      }
+
+      RunBatches();
+
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (--busy_workers_ == 0)
+      {
+        done_cv_.notify_one();
+      }
+    }
+  }
+
+  void InitJobSystem()
+  {
+    const size_t thread_count = std::thread::hardware_concurrency();
+
+    job_system = std::make_unique<JobSystem>(thread_count > 1 ? thread_count - 1 : 0);
+  }
+
+  void CleanUpJobSystem()
+  {
+    job_system.reset();
+  }
+
+  void ParallelFor(size_t count, size_t batch_size, const JobFunction& job)
+  {
+    if (job_system != nullptr)
+    {
+      job_system->ParallelFor(count, batch_size, job);
+    }
+    else if (count > 0)
+    {
+      job(0, count);
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/// @author James Holtom
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace term_engine::utility {
+  class JobSystem;
+
+  /// @brief Used to run a job over a range of items, from _begin_ up to (but not including) _end_.
+  typedef std::function<void(size_t begin, size_t end)> JobFunction;
+  /// @brief Unique pointer to a job system.
+  typedef std::unique_ptr<JobSystem> JobSystemPtr;
+
+  /**
+   * @brief Runs jobs across a pool of worker threads.
+   * @details Jobs are split into batches of items, which the workers and the calling thread take in turn until none are left.
+   *          Jobs must not call into Lua, as the Lua state is only used from the main thread.
+   */
+  class JobSystem {
+  public:
+    /**
+     * @brief Constructs the job system, and starts the worker threads.
+     * 
+     * @param[in] worker_count The number of worker threads to start. If 0, jobs are run on the calling thread.
+     */
+    JobSystem(size_t worker_count);
+
+    /// @brief Stops and joins the worker threads.
+    ~JobSystem();
+
+    /**
+     * @brief Returns the number of worker threads.
+     * 
+     * @returns The number of workers.
+     */
+    size_t GetWorkerCount() const;
+
+    /**
+     * @brief Runs a job over the given number of items, and waits for it to finish.
+     * @note Only one job can run at a time, so this must only be called from the main thread.
+     * 
+     * @param[in] count      The number of items.
+     * @param[in] batch_size The number of items in each batch that is given to a worker.
+     * @param[in] job        The job to run on each batch.
+     */
+    void ParallelFor(size_t count, size_t batch_size, const JobFunction& job);
+
+  protected:
+    /// @brief The worker threads.
+    std::vector<std::thread> workers_;
+    /// @brief Guards the current job and the worker state.
+    std::mutex mutex_;
+    /// @brief Signals the workers that a job has started, or that they should stop.
+    std::condition_variable job_cv_;
+    /// @brief Signals that every worker has finished the current job.
+    std::condition_variable done_cv_;
+    /// @brief The job being run.
+    const JobFunction* job_;
+    /// @brief The number of items in the job being run.
+    size_t count_;
+    /// @brief The number of items in each batch of the job being run.
+    size_t batch_size_;
+    /// @brief The first item of the next batch to be taken.
+    std::atomic<size_t> next_item_;
+    /// @brief The number of workers that haven't finished the current job.
+    size_t busy_workers_;
+    /// @brief Increased each time a job starts, so that workers can tell when there is a new job.
+    uint64_t job_generation_;
+    /// @brief Should the workers stop?
+    bool is_stopping_;
+
+    /// @brief Takes batches from the current job and runs them, until there are none left.
+    void RunBatches();
+
+    /// @brief Waits for jobs and runs them on a worker thread, until the job system is destroyed.
+    void Run();
+  };
+
+  /// @brief The number of items in each batch when updating game objects.
+  constexpr size_t OBJECT_JOB_BATCH_SIZE = 256;
+  /// @brief The number of rows in each batch when drawing to a character map.
+  constexpr size_t ROW_JOB_BATCH_SIZE = 8;
+
+  /// @brief The job system used to update and draw game objects.
+  inline JobSystemPtr job_system;
+
+  /// @brief Starts the job system, with a worker for each hardware thread other than the main thread.
+  void InitJobSystem();
+
+  /// @brief Stops the job system.
+  void CleanUpJobSystem();
+
+  /**
+   * @brief Runs a job over the given number of items using the job system, or on the calling thread if it hasn't been started.
+   * 
+   * @param[in] count      The number of items.
+   * @param[in] batch_size The number of items in each batch that is given to a worker.
+   * @param[in] job        The job to run on each batch.
+   */
+  void ParallelFor(size_t count, size_t batch_size, const JobFunction& job);
+}
+
+#endif // ! JOB_SYSTEM_H
@@ -18,6 +18,14 @@ namespace term_engine::utility {
     return true;
   }
 
+  void UseHeadlessDrivers()
+  {
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, HEADLESS_VIDEO_DRIVER);
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, HEADLESS_AUDIO_DRIVER);
+
+    LogDebug("Using headless SDL drivers.");
+  }
+
   void CleanUpSDL()
   {
     SDL_Quit();
@@ -9,6 +9,10 @@
 namespace term_engine::utility {
   /// @brief The flags to initialise SDL with.
   constexpr uint32_t SDL_INIT_FLAGS = SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_JOYSTICK | SDL_INIT_GAMECONTROLLER;
+  /// @brief The video driver to use when running without a display. This creates windows and OpenGL contexts (through EGL) that are never shown.
+  constexpr char HEADLESS_VIDEO_DRIVER[] = "offscreen";
+  /// @brief The audio driver to use when running without a display, which discards any sound played.
+  constexpr char HEADLESS_AUDIO_DRIVER[] = "dummy";
 
   /**
    * @brief Initialises SDL.
@@ -17,6 +21,12 @@ namespace term_engine::utility {
    */
   bool InitSDL();
 
+  /**
+   * @brief Tells SDL to use drivers that don't need a display or sound device, e.g. for running benchmarks on a build server.
+   * @note This must be called before SDL is initialised.
+   */
+  void UseHeadlessDrivers();
+
   /// @brief Shuts down SDL.
   void CleanUpSDL();
 }
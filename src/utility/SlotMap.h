@@ -0,0 +1,377 @@
+/// @author James Holtom
+
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace term_engine::utility {
+  /// @brief Used to refer to an item in a slot map. The lower 32 bits are the slot index (plus 1), the next 24 bits are the slot's generation, and the upper 8 bits are the slot map's tag.
+  typedef uint64_t SlotHandle;
+
+  /// @brief A handle that never refers to an item.
+  constexpr SlotHandle NULL_SLOT_HANDLE = 0;
+
+  /**
+   * @brief Returns the tag of the slot map that the given handle belongs to.
+   * 
+   * @param[in] handle The handle.
+   * @returns The slot map's tag.
+   */
+  constexpr uint8_t GetSlotHandleTag(SlotHandle handle)
+  {
+    return (uint8_t)(handle >> 56);
+  }
+
+  /**
+   * @brief Returns the index of the slot that the given handle refers to.
+   * @note The handle must not be the null handle.
+   * 
+   * @param[in] handle The handle.
+   * @returns The slot index.
+   */
+  constexpr uint32_t GetSlotHandleIndex(SlotHandle handle)
+  {
+    return (uint32_t)(handle & 0xFFFFFFFF) - 1;
+  }
+
+  /**
+   * @brief Stores items in a contiguous array, which are referred to by stable handles.
+   * @details Each handle refers to a slot, which stores where the item is in the array. When an item is removed, the last item is moved into its place, and the slot's generation is increased so that old handles no longer refer to anything.
+   *          This gives constant-time insertion, lookup and removal, while keeping the items packed together for iteration.
+   * 
+   * @tparam T The type of item to store.
+   */
+  template<typename T>
+  class SlotMap {
+  public:
+    /// @brief Used to iterate over the items in the slot map.
+    typedef typename std::vector<T>::iterator iterator;
+    /// @brief Used to iterate over the items in the slot map, without modifying them.
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    /**
+     * @brief Constructs the slot map.
+     * 
+     * @param[in] tag The tag added to every handle from this slot map, so that handles from different slot maps can be told apart.
+     */
+    explicit SlotMap(uint8_t tag = 0) :
+      tag_(tag) {}
+
+    /**
+     * @brief Returns the tag added to every handle from this slot map.
+     * 
+     * @returns The slot map's tag.
+     */
+    uint8_t GetTag() const
+    {
+      return tag_;
+    }
+
+    /**
+     * @brief Returns the handle that the next inserted item will be given.
+     * 
+     * @returns The next handle.
+     */
+    SlotHandle GetNextHandle() const
+    {
+      if (free_slots_.empty())
+      {
+        return MakeHandle((uint32_t)slots_.size(), 0);
+      }
+      else
+      {
+        const uint32_t slot_index = free_slots_.back();
+
+        return MakeHandle(slot_index, slots_[slot_index].generation_);
+      }
+    }
+
+    /**
+     * @brief Adds an item to the slot map.
+     * 
+     * @param[in] item The item to add.
+     * @returns The handle referring to the item.
+     */
+    SlotHandle Insert(T&& item)
+    {
+      uint32_t slot_index;
+
+      if (free_slots_.empty())
+      {
+        slot_index = (uint32_t)slots_.size();
+        slots_.push_back({ 0, 0 });
+      }
+      else
+      {
+        slot_index = free_slots_.back();
+        free_slots_.pop_back();
+      }
+
+      slots_[slot_index].item_index_ = (uint32_t)items_.size();
+      items_.push_back(std::move(item));
+      item_slots_.push_back(slot_index);
+
+      return MakeHandle(slot_index, slots_[slot_index].generation_);
+    }
+
+    /**
+     * @brief Returns the item that the given handle refers to.
+     * 
+     * @param[in] handle The handle of the item.
+     * @returns A raw pointer to the item, or a null pointer if the handle does not refer to an item.
+     */
+    T* Get(SlotHandle handle)
+    {
+      const Slot* slot = GetSlot(handle);
+
+      return slot != nullptr ? &items_[slot->item_index_] : nullptr;
+    }
+
+    /**
+     * @brief Returns if the given handle refers to an item.
+     * 
+     * @param[in] handle The handle to check.
+     * @returns If the handle refers to an item.
+     */
+    bool Contains(SlotHandle handle) const
+    {
+      return GetSlot(handle) != nullptr;
+    }
+
+    /**
+     * @brief Removes the item that the given handle refers to.
+     * 
+     * @param[in] handle The handle of the item.
+     * @returns If an item was removed.
+     */
+    bool Remove(SlotHandle handle)
+    {
+      const Slot* slot = GetSlot(handle);
+
+      if (slot == nullptr)
+      {
+        return false;
+      }
+
+      RemoveAt(slot->item_index_);
+
+      return true;
+    }
+
+    /**
+     * @brief Removes every item that matches the given predicate.
+     * @note The order of the remaining items is not preserved.
+     * 
+     * @tparam Predicate The type of the predicate.
+     * @param[in] predicate A function that returns true for the items to remove.
+     * @returns The number of items removed.
+     */
+    template<typename Predicate>
+    size_t RemoveIf(Predicate predicate)
+    {
+      size_t count = 0;
+      size_t index = 0;
+
+      while (index < items_.size())
+      {
+        if (predicate(items_[index]))
+        {
+          // The last item is moved into this index, so check the same index again.
+          RemoveAt(index);
+          ++count;
+        }
+        else
+        {
+          ++index;
+        }
+      }
+
+      return count;
+    }
+
+    /**
+     * @brief Sorts the items, without changing which items the handles refer to.
+     * 
+     * @tparam Compare The type of the comparison function.
+     * @param[in] compare A function that returns true if the first item should come before the second. This must be a strict weak ordering.
+     */
+    template<typename Compare>
+    void Sort(Compare compare)
+    {
+      std::vector<uint32_t> order(items_.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [this, &compare](uint32_t lhs, uint32_t rhs) { return compare(items_[lhs], items_[rhs]); });
+
+      std::vector<T> sorted_items;
+      std::vector<uint32_t> sorted_slots;
+      sorted_items.reserve(items_.size());
+      sorted_slots.reserve(items_.size());
+
+      for (uint32_t index : order)
+      {
+        sorted_items.push_back(std::move(items_[index]));
+        sorted_slots.push_back(item_slots_[index]);
+        slots_[item_slots_[index]].item_index_ = (uint32_t)(sorted_slots.size() - 1);
+      }
+
+      items_.swap(sorted_items);
+      item_slots_.swap(sorted_slots);
+    }
+
+    /// @brief Removes all items, so that no existing handles refer to anything.
+    void Clear()
+    {
+      for (uint32_t slot_index : item_slots_)
+      {
+        ReleaseSlot(slot_index);
+      }
+
+      items_.clear();
+      item_slots_.clear();
+    }
+
+    /**
+     * @brief Returns the number of items in the slot map.
+     * 
+     * @returns The number of items.
+     */
+    size_t Size() const
+    {
+      return items_.size();
+    }
+
+    /**
+     * @brief Returns if the slot map has no items.
+     * 
+     * @returns If the slot map is empty.
+     */
+    bool Empty() const
+    {
+      return items_.empty();
+    }
+
+    /**
+     * @brief Returns the item at the given position in the array.
+     * @note Positions change as items are removed, so use handles to refer to items over time.
+     * 
+     * @param[in] index The position of the item.
+     * @returns A reference to the item.
+     */
+    T& operator[](size_t index)
+    {
+      return items_[index];
+    }
+
+    /// @brief Returns an iterator to the first item.
+    iterator begin() { return items_.begin(); }
+    /// @brief Returns an iterator to the end of the items.
+    iterator end() { return items_.end(); }
+    /// @brief Returns an iterator to the first item.
+    const_iterator begin() const { return items_.begin(); }
+    /// @brief Returns an iterator to the end of the items.
+    const_iterator end() const { return items_.end(); }
+
+  private:
+    /// @brief The bits of a slot's generation that are stored in its handles. Slots that reach this generation are never reused.
+    static constexpr uint32_t GENERATION_MASK = 0xFFFFFF;
+
+    /// @brief Stores where an item is in the array, and how many times the slot has been reused.
+    struct Slot {
+      /// @brief The position of the item in the array.
+      uint32_t item_index_;
+      /// @brief The number of times an item in this slot has been removed.
+      uint32_t generation_;
+    };
+
+    /// @brief The tag added to every handle from this slot map.
+    uint8_t tag_;
+    /// @brief The items, packed together.
+    std::vector<T> items_;
+    /// @brief The slot belonging to each item in the array.
+    std::vector<uint32_t> item_slots_;
+    /// @brief The slots that handles refer to.
+    std::vector<Slot> slots_;
+    /// @brief The slots that are not in use, and can be given to new items.
+    std::vector<uint32_t> free_slots_;
+
+    /**
+     * @brief Creates a handle for the given slot.
+     * 
+     * @param[in] slot_index The index of the slot.
+     * @param[in] generation The generation of the slot.
+     * @returns The handle.
+     */
+    SlotHandle MakeHandle(uint32_t slot_index, uint32_t generation) const
+    {
+      return ((SlotHandle)tag_ << 56) | ((SlotHandle)(generation & GENERATION_MASK) << 32) | ((SlotHandle)slot_index + 1);
+    }
+
+    /**
+     * @brief Returns the slot that the given handle refers to.
+     * 
+     * @param[in] handle The handle.
+     * @returns A raw pointer to the slot, or a null pointer if the handle does not refer to an item.
+     */
+    const Slot* GetSlot(SlotHandle handle) const
+    {
+      const uint64_t slot_index = (handle & 0xFFFFFFFF) - 1;
+      const uint32_t generation = (uint32_t)(handle >> 32) & GENERATION_MASK;
+
+      if (handle == NULL_SLOT_HANDLE || GetSlotHandleTag(handle) != tag_ || slot_index >= slots_.size() || (slots_[slot_index].generation_ & GENERATION_MASK) != generation)
+      {
+        return nullptr;
+      }
+
+      // Free slots keep their generation, so check the slot is still in use.
+      const Slot& slot = slots_[slot_index];
+
+      return (slot.item_index_ < item_slots_.size() && item_slots_[slot.item_index_] == slot_index) ? &slot : nullptr;
+    }
+
+    /**
+     * @brief Removes the item at the given position in the array, moving the last item into its place.
+     * 
+     * @param[in] index The position of the item.
+     */
+    void RemoveAt(size_t index)
+    {
+      const uint32_t slot_index = item_slots_[index];
+
+      if (index != items_.size() - 1)
+      {
+        items_[index] = std::move(items_.back());
+        item_slots_[index] = item_slots_.back();
+        slots_[item_slots_[index]].item_index_ = (uint32_t)index;
+      }
+
+      items_.pop_back();
+      item_slots_.pop_back();
+
+      ReleaseSlot(slot_index);
+    }
+
+    /**
+     * @brief Increases the generation of a slot that is no longer in use, so that it can be given to a new item.
+     * @details Once the generation reaches _GENERATION_MASK_ the slot is retired rather than reused, as the next generation would wrap around and let old handles refer to new items.
+     * 
+     * @param[in] slot_index The index of the slot.
+     */
+    void ReleaseSlot(uint32_t slot_index)
+    {
+      Slot& slot = slots_[slot_index];
+
+      ++slot.generation_;
+
+      if (slot.generation_ < GENERATION_MASK)
+      {
+        free_slots_.push_back(slot_index);
+      }
+    }
+  };
+}
+
+#endif // ! SLOT_MAP_H
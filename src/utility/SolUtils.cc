@@ -23,7 +23,7 @@ namespace term_engine::utility {
     }
   }
 
-  void CallWithTimestep(sol::protected_function func, float timestep)
+  void CallWithTimestep(sol::protected_function func, double timestep)
   {
     if (!func.valid())
     {
@@ -18,9 +18,9 @@ namespace term_engine::utility {
    * @brief Calls the given Lua function, passing the timestep and handling exceptions.
    * 
    * @param[in] func The Lua function to call.
-   * @param timestep The timestep.
+   * @param timestep The timestep, in the unit of time passed to Lua.
    */
-  void CallWithTimestep(sol::protected_function func, float timestep);
+  void CallWithTimestep(sol::protected_function func, double timestep);
 
   /**
    * @brief Calls the given Lua function with exception handling.